@@ -0,0 +1,62 @@
+// include/my_cow_ptr.hpp
+#ifndef MY_COW_PTR_HPP
+#define MY_COW_PTR_HPP
+
+#include "my_smart_ptr.hpp"
+
+#include <utility>
+
+namespace my_std {
+
+// ====================================================================================
+//                                  MyCowPtr (Copy-On-Write)
+// ====================================================================================
+// 拷贝 MyCowPtr 只是拷贝一个 MySharedPtr（计数 +1），所有副本共享同一个只读对象；
+// 只有通过 write() 申请可写访问、并且对象正被别人共享时，才真正克隆一份。
+//
+// 并发下“是否独占”的判断：
+//   - use_count() 以 acquire 读取强计数，其他副本释放时的 fetch_sub 是 acq_rel，
+//     因此看到 1 时，其他线程之前对该对象的读取都已“发生在前”，此时原地修改是安全的。
+//   - 看到 1 之后计数不可能再被别人增加：唯一的强引用在本对象手里，而 MyCowPtr
+//     不对外暴露 MyWeakPtr，没有其他途径 lock() 出新的强引用。
+//   - 同一个 MyCowPtr 实例本身不能被多个线程同时 write()，这与普通值类型的约束一致。
+template <typename T>
+class MyCowPtr {
+public:
+    MyCowPtr() = default;
+    explicit MyCowPtr(T* ptr) : _shared(ptr) {}
+
+    // 就地构造一个新对象
+    template <typename... Args>
+    static MyCowPtr make(Args&&... args) {
+        return MyCowPtr(new T(std::forward<Args>(args)...));
+    }
+
+    // 拷贝/移动均使用默认实现：拷贝即共享，移动即转交
+    MyCowPtr(const MyCowPtr&) = default;
+    MyCowPtr& operator=(const MyCowPtr&) = default;
+    MyCowPtr(MyCowPtr&&) noexcept = default;
+    MyCowPtr& operator=(MyCowPtr&&) noexcept = default;
+
+    // 只读访问：永远不会触发拷贝
+    const T& operator*() const { return *_shared; }
+    const T* operator->() const { return _shared.get(); }
+    const T* get() const { return _shared.get(); }
+
+    // 可写访问：对象被共享时先克隆一份（T 需要可拷贝构造），之后本实例独占新副本
+    T& write() {
+        if (_shared && !unique())
+            _shared = MySharedPtr<T>(new T(*_shared));
+        return *_shared.get();
+    }
+
+    bool unique() const { return _shared.use_count() == 1; }
+    int use_count() const { return _shared.use_count(); }
+    explicit operator bool() const { return static_cast<bool>(_shared); }
+
+private:
+    MySharedPtr<T> _shared;
+};
+
+} // namespace my_std
+#endif // MY_COW_PTR_HPP
@@ -0,0 +1,208 @@
+// include/my_ptr_stats.hpp
+#ifndef MY_PTR_STATS_HPP
+#define MY_PTR_STATS_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// ====================================================================================
+//                                  按类型的存活统计
+// ====================================================================================
+// 可选的调试统计：在包含 my_smart_ptr.hpp 之前定义 MY_SMART_PTR_STATS 即开启，
+// release 构建 (NDEBUG) 下无论是否定义都会被整体编译掉，此时 snapshot() 返回空表。
+//
+// 统计口径（每个 T 一行）：
+//   live_objects      仍然存活的托管对象数
+//   live_blocks       仍然存在的控制块数（包括只剩弱引用的）
+//   weak_only_blocks  对象已析构、但因 MyWeakPtr 未释放而滞留的控制块数
+//   bytes             live_objects * sizeof(T) + live_blocks * sizeof(ControlBlock)
+//
+// 实现：每个线程一份计数分片 (thread_local)，热路径只做“本线程独写”的 relaxed 读改写，
+// 没有跨核争用；snapshot() 加锁把所有分片求和。对象可能在 A 线程创建、B 线程释放，
+// 单个分片的计数因此可能为负，只有求和结果有意义。线程退出时分片并入全局的 retired 分片。
+#if defined(MY_SMART_PTR_STATS) && !defined(NDEBUG)
+#define MY_SMART_PTR_STATS_ENABLED 1
+#endif
+
+namespace my_std {
+namespace ptr_stats {
+
+struct TypeStats {
+    std::string type_name;
+    size_t object_size = 0;
+    long long live_objects = 0;
+    long long live_blocks = 0;
+    long long weak_only_blocks = 0;
+    long long bytes = 0;
+};
+
+} // namespace ptr_stats
+} // namespace my_std
+
+#ifdef MY_SMART_PTR_STATS_ENABLED
+
+#include <atomic>
+#include <mutex>
+#include <typeinfo>
+
+namespace my_std {
+namespace ptr_stats {
+
+// 可统计的类型数上限；超出的类型全部计入最后一个 "(other types)" 槽位
+constexpr size_t kMaxTypes = 256;
+
+struct Counters {
+    std::atomic<long long> objects{0};
+    std::atomic<long long> blocks{0};
+    std::atomic<long long> weak_only{0};
+};
+
+struct Shard {
+    Counters counters[kMaxTypes];
+};
+
+// 只有拥有者线程会写自己的分片，因此不需要 fetch_add，load + store 即可
+inline void bump(std::atomic<long long>& c, long long delta) {
+    if (delta) c.store(c.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+class Registry {
+public:
+    // 故意泄漏：保证在所有 thread_local 分片析构之后仍然可用
+    static Registry& instance() {
+        static Registry* registry = new Registry;
+        return *registry;
+    }
+
+    size_t register_type(const char* name, size_t object_size, size_t block_size) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_types.size() == kMaxTypes - 1)
+            _types.push_back({"(other types)", 0, block_size});
+        if (_types.size() >= kMaxTypes)
+            return kMaxTypes - 1;
+        _types.push_back({name, object_size, block_size});
+        return _types.size() - 1;
+    }
+
+    void attach(Shard* shard) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _shards.push_back(shard);
+    }
+
+    // 线程退出：把该线程的计数并入 retired 分片后摘除
+    void detach(Shard* shard) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i < kMaxTypes; ++i) {
+            bump(_retired.counters[i].objects, shard->counters[i].objects.load(std::memory_order_relaxed));
+            bump(_retired.counters[i].blocks, shard->counters[i].blocks.load(std::memory_order_relaxed));
+            bump(_retired.counters[i].weak_only, shard->counters[i].weak_only.load(std::memory_order_relaxed));
+        }
+        for (size_t i = 0; i < _shards.size(); ++i) {
+            if (_shards[i] == shard) {
+                _shards[i] = _shards.back();
+                _shards.pop_back();
+                break;
+            }
+        }
+    }
+
+    // 各分片并非在同一瞬间读取，并发变化时结果是近似值；静止时精确
+    std::vector<TypeStats> snapshot() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<TypeStats> result(_types.size());
+        for (size_t i = 0; i < _types.size(); ++i) {
+            TypeStats& s = result[i];
+            s.type_name = _types[i].name;
+            s.object_size = _types[i].object_size;
+            add(s, _retired.counters[i]);
+            for (Shard* shard : _shards)
+                add(s, shard->counters[i]);
+            s.bytes = s.live_objects * static_cast<long long>(_types[i].object_size) +
+                      s.live_blocks * static_cast<long long>(_types[i].block_size);
+        }
+        return result;
+    }
+
+private:
+    struct TypeInfo {
+        const char* name;
+        size_t object_size;
+        size_t block_size;
+    };
+
+    static void add(TypeStats& s, const Counters& c) {
+        s.live_objects += c.objects.load(std::memory_order_relaxed);
+        s.live_blocks += c.blocks.load(std::memory_order_relaxed);
+        s.weak_only_blocks += c.weak_only.load(std::memory_order_relaxed);
+    }
+
+    std::mutex _mutex;
+    std::vector<TypeInfo> _types;
+    std::vector<Shard*> _shards;
+    Shard _retired;
+};
+
+inline Shard& local_shard() {
+    struct Holder {
+        Shard shard;
+        Holder() { Registry::instance().attach(&shard); }
+        ~Holder() { Registry::instance().detach(&shard); }
+    };
+    thread_local Holder holder;
+    return holder.shard;
+}
+
+template <typename T>
+size_t type_id(size_t block_size) {
+    static const size_t id = Registry::instance().register_type(typeid(T).name(), sizeof(T), block_size);
+    return id;
+}
+
+// 由 my_smart_ptr.hpp 在控制块生命周期的各个节点调用
+template <typename T>
+void record(size_t block_size, long long objects, long long blocks, long long weak_only) {
+    Counters& c = local_shard().counters[type_id<T>(block_size)];
+    bump(c.objects, objects);
+    bump(c.blocks, blocks);
+    bump(c.weak_only, weak_only);
+}
+
+inline std::vector<TypeStats> snapshot() { return Registry::instance().snapshot(); }
+
+} // namespace ptr_stats
+} // namespace my_std
+
+#else // !MY_SMART_PTR_STATS_ENABLED
+
+namespace my_std {
+namespace ptr_stats {
+
+inline std::vector<TypeStats> snapshot() { return {}; }
+
+} // namespace ptr_stats
+} // namespace my_std
+
+#endif // MY_SMART_PTR_STATS_ENABLED
+
+namespace my_std {
+namespace ptr_stats {
+
+// 以表格形式输出当前快照，可在运行时任意时刻调用
+inline void dump(std::ostream& os) {
+#ifdef MY_SMART_PTR_STATS_ENABLED
+    os << "type | sizeof | live objects | live blocks | weak-only blocks | bytes\n";
+    for (const TypeStats& s : snapshot()) {
+        os << s.type_name << " | " << s.object_size << " | " << s.live_objects << " | "
+           << s.live_blocks << " | " << s.weak_only_blocks << " | " << s.bytes << "\n";
+    }
+#else
+    os << "smart pointer stats disabled (define MY_SMART_PTR_STATS in a debug build)\n";
+#endif
+}
+
+} // namespace ptr_stats
+} // namespace my_std
+
+#endif // MY_PTR_STATS_HPP
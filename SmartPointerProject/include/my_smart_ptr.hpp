@@ -2,13 +2,19 @@
 #ifndef MY_SMART_PTR_HPP
 #define MY_SMART_PTR_HPP
 
+#include <atomic>  // for std::atomic
+#include <cassert> // for assert (MyBorrowPtr 的借用检查)
+#include <cstddef> // for size_t
 #include <utility> // for std::move
 
+#include "my_ptr_stats.hpp" // 可选的按类型存活统计 (MY_SMART_PTR_STATS)
+
 namespace my_std {
 
 // 前向声明
 template<typename T> class MySharedPtr;
 template<typename T> class MyWeakPtr;
+template<typename T> class MyBorrowPtr;
 
 // ====================================================================================
 //                                  MyUniquePtr 框架
@@ -72,14 +78,46 @@ private:
 //                                  ControlBlock & Co. 框架
 // ====================================================================================
 // TODO 2.1: 定义控制块结构体
+// 计数使用原子变量，允许不同线程各自持有同一对象的 MySharedPtr / MyWeakPtr。
+// 约定（与 libstdc++ 相同）：只要 strong_count > 0，weak_count 中就额外包含 1，
+// 这样“最后一个强引用”和“最后一个弱引用”之间不会因为同时看到两个 0 而重复 delete 控制块。
 struct ControlBlock {
-    size_t strong_count = 0;
-    size_t weak_count = 0;
+    std::atomic<size_t> strong_count{0};
+    std::atomic<size_t> weak_count{0};
+#ifdef MY_PTR_BORROW_CHECK
+    // 仅开启借用检查时存在：仍然存活的 MyBorrowPtr 数量，对象析构时必须为 0
+    std::atomic<size_t> borrow_count{0};
+#endif
+
+    // 仅当对象仍然存活时才增加强引用（lock() 使用），返回是否成功
+    bool try_add_strong() {
+        size_t n = strong_count.load(std::memory_order_relaxed);
+        while (n != 0) {
+            if (strong_count.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    // 释放一个弱引用，返回控制块是否应被删除
+    bool release_weak() {
+        return weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
 };
 
+// 统计钩子：未开启统计时展开为空语句
+#ifdef MY_SMART_PTR_STATS_ENABLED
+#define MY_PTR_STATS_RECORD(T, objects, blocks, weak_only) \
+    ::my_std::ptr_stats::record<T>(sizeof(::my_std::ControlBlock), objects, blocks, weak_only)
+#else
+#define MY_PTR_STATS_RECORD(T, objects, blocks, weak_only) ((void)0)
+#endif
+
 template <typename T>
 class MySharedPtr {
     friend class MyWeakPtr<T>;
+    friend class MyBorrowPtr<T>;
 public:
     // TODO 2.2: 实现构造函数
     explicit MySharedPtr(T* ptr = nullptr) { 
@@ -88,8 +126,9 @@ public:
             _control_block = nullptr;
         }else{
             _control_block = new ControlBlock;
-            _control_block->strong_count = 1;
-            _control_block->weak_count = 0;
+            _control_block->strong_count.store(1, std::memory_order_relaxed);
+            _control_block->weak_count.store(1, std::memory_order_relaxed);
+            MY_PTR_STATS_RECORD(T, 1, 1, 0);
         }
 
     }
@@ -103,7 +142,7 @@ public:
         _ptr = other._ptr;
         _control_block = other._control_block;
         if(_control_block != nullptr)
-            _control_block->strong_count++;
+            _control_block->strong_count.fetch_add(1, std::memory_order_relaxed);
     }
     MySharedPtr& operator=(const MySharedPtr& other) { 
         if(this != &other){
@@ -113,7 +152,7 @@ public:
             _ptr = other._ptr;
             _control_block = other._control_block;
             if(_control_block != nullptr)
-                _control_block->strong_count++;
+                _control_block->strong_count.fetch_add(1, std::memory_order_relaxed);
         }
         return *this; 
     }
@@ -137,11 +176,11 @@ public:
     }
     
     // TODO 2.6: 实现从 MyWeakPtr 构造 (用于 lock())
+    // 注意：不能先 expired() 再 ++，两步之间对象可能已被其他线程释放，必须用 CAS
     MySharedPtr(const MyWeakPtr<T>& weak) {  
-        if(!weak.expired()){
+        if(weak._control_block && weak._control_block->try_add_strong()){
             _ptr = weak._ptr;
             _control_block = weak._control_block;
-            _control_block->strong_count++;
         }else {
             _ptr = nullptr;
             _control_block = nullptr;
@@ -154,14 +193,15 @@ public:
         if(ptr != nullptr){
             _ptr = ptr;
             _control_block = new ControlBlock;
-            _control_block->strong_count = 1;
-            _control_block->weak_count = 0;
+            _control_block->strong_count.store(1, std::memory_order_relaxed);
+            _control_block->weak_count.store(1, std::memory_order_relaxed);
+            MY_PTR_STATS_RECORD(T, 1, 1, 0);
         }
     }
 
     int use_count() const { 
         if(_control_block)
-            return _control_block->strong_count; 
+            return static_cast<int>(_control_block->strong_count.load(std::memory_order_acquire)); 
         return 0;
     }
     T* get() const { return _ptr; }
@@ -174,11 +214,18 @@ private:
     void release() {
         if (_control_block == nullptr) return;
 
-        _control_block->strong_count--;
-        if (_control_block->strong_count == 0) {
+        if (_control_block->strong_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+#ifdef MY_PTR_BORROW_CHECK
+            assert(_control_block->borrow_count.load(std::memory_order_acquire) == 0 &&
+                   "MySharedPtr: object destroyed while a MyBorrowPtr is still alive");
+#endif
             delete _ptr;
-            if (_control_block->weak_count == 0) {
+            // 归还所有强引用共同持有的那 1 个弱计数
+            if (_control_block->release_weak()) {
                 delete _control_block;
+                MY_PTR_STATS_RECORD(T, -1, -1, 0);
+            } else {
+                MY_PTR_STATS_RECORD(T, -1, 0, 1); // 控制块因弱引用滞留
             }
         }
 
@@ -201,7 +248,7 @@ public:
         _ptr = shared._ptr;
         _control_block = shared._control_block;   
         if(shared._control_block)
-            shared._control_block->weak_count++;
+            shared._control_block->weak_count.fetch_add(1, std::memory_order_relaxed);
     }
 
     // TODO 3.2: 实现析构函数
@@ -213,7 +260,7 @@ public:
         _ptr = other._ptr;
         _control_block = other._control_block;
         if(_control_block)
-            _control_block->weak_count++;
+            _control_block->weak_count.fetch_add(1, std::memory_order_relaxed);
     }
     MyWeakPtr& operator=(const MyWeakPtr& other) { 
         if(this != &other){
@@ -221,7 +268,7 @@ public:
             _ptr = other._ptr;
             _control_block = other._control_block;
             if(_control_block)
-                _control_block->weak_count++;
+                _control_block->weak_count.fetch_add(1, std::memory_order_relaxed);
         }
         return *this;
     }
@@ -246,13 +293,13 @@ public:
     // TODO 3.3: 实现核心功能
     bool expired() const { 
         if(_control_block)
-            return _control_block->strong_count == 0; 
+            return _control_block->strong_count.load(std::memory_order_acquire) == 0; 
         return 1;
     }
     MySharedPtr<T> lock() const { return MySharedPtr<T>(*this); }
     int use_count() const { 
         if(_control_block)
-            return _control_block->strong_count; 
+            return static_cast<int>(_control_block->strong_count.load(std::memory_order_acquire)); 
         return 0;
     }
 
@@ -260,14 +307,86 @@ private:
     // TODO 3.4: 实现私有的 release 辅助函数
     void release() { 
         if(_control_block){
-            _control_block->weak_count--;
-            if(_control_block->strong_count == 0 && _control_block->weak_count == 0) 
+            if(_control_block->release_weak()) {
                 delete _control_block;
+                MY_PTR_STATS_RECORD(T, 0, -1, -1);
+            }
+        }
+        _ptr = nullptr;
+        _control_block = nullptr;
+    }
+
+    T* _ptr {nullptr};
+    ControlBlock* _control_block {nullptr};
+};
+
+// ====================================================================================
+//                                  MyBorrowPtr 非拥有借用指针
+// ====================================================================================
+// 用于函数参数：void f(MyBorrowPtr<T> p) 可以直接接收 MySharedPtr / MyUniquePtr，
+// 调用时不产生引用计数的加减（按值传 MySharedPtr 每次调用都有一对原子操作）。
+//   - 默认：只有一个 T*，可平凡拷贝，开销与裸指针相同。
+//   - 在包含本头文件之前定义 MY_PTR_BORROW_CHECK：额外持有控制块，借用期间 borrow_count 与 weak_count 各 +1，
+//     若对象在借用未结束时被析构，MySharedPtr::release() 中的 assert 会立即报错（NDEBUG 下只记账不报错）；
+//     多持有的那个弱计数保证控制块本身活得比借用久，检查不会读到已释放内存。
+//   - 从 MyUniquePtr 借用时没有控制块可记账，开启检查也只是裸指针。
+// 这个宏会改变 ControlBlock 与 MyBorrowPtr 的布局，所以不跟随 NDEBUG：同一程序的所有翻译单元必须一致地定义或不定义它。
+// 借用指针不能延长对象寿命，也不能从临时的 MySharedPtr 构造（那样一出表达式就悬空）。
+template <typename T>
+class MyBorrowPtr {
+public:
+    MyBorrowPtr() = default;
+    MyBorrowPtr(const MySharedPtr<T>& owner) : _ptr(owner._ptr) {
+#ifdef MY_PTR_BORROW_CHECK
+        attach(owner._control_block);
+#endif
+    }
+    MyBorrowPtr(const MyUniquePtr<T>& owner) : _ptr(owner.get()) {}
+    MyBorrowPtr(MySharedPtr<T>&&) = delete;
+    MyBorrowPtr(MyUniquePtr<T>&&) = delete;
+
+#ifdef MY_PTR_BORROW_CHECK
+    MyBorrowPtr(const MyBorrowPtr& other) : _ptr(other._ptr) { attach(other._control_block); }
+    MyBorrowPtr& operator=(const MyBorrowPtr& other) {
+        if (this != &other) {
+            detach();
+            _ptr = other._ptr;
+            attach(other._control_block);
         }
+        return *this;
     }
+    ~MyBorrowPtr() { detach(); }
+#endif
+
+    T* get() const { return _ptr; }
+    T& operator*() const { return *_ptr; }
+    T* operator->() const { return _ptr; }
+    explicit operator bool() const { return _ptr != nullptr; }
 
+private:
     T* _ptr {nullptr};
+
+#ifdef MY_PTR_BORROW_CHECK
+    void attach(ControlBlock* cb) {
+        _control_block = cb;
+        if (_control_block) {
+            _control_block->borrow_count.fetch_add(1, std::memory_order_relaxed);
+            _control_block->weak_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    void detach() {
+        if (_control_block) {
+            _control_block->borrow_count.fetch_sub(1, std::memory_order_release);
+            if (_control_block->release_weak()) {
+                delete _control_block;
+                MY_PTR_STATS_RECORD(T, 0, -1, -1);
+            }
+        }
+        _control_block = nullptr;
+    }
+
     ControlBlock* _control_block {nullptr};
+#endif
 };
 
 } // namespace my_std
@@ -0,0 +1,136 @@
+// include/my_weak_value_cache.hpp
+#ifndef MY_WEAK_VALUE_CACHE_HPP
+#define MY_WEAK_VALUE_CACHE_HPP
+
+#include "my_smart_ptr.hpp"
+
+#include <algorithm>     // for std::max
+#include <cstddef>
+#include <functional>    // for std::hash
+#include <mutex>
+#include <shared_mutex>  // for std::shared_mutex (C++17)
+#include <unordered_map>
+#include <utility>
+
+namespace my_std {
+
+// ====================================================================================
+//                                  WeakValueCache
+// ====================================================================================
+// 以 key 去重的“享元”缓存：表里只保存 MyWeakPtr，对象的生命周期仍由外部的 MySharedPtr 决定。
+//   - 分片 (shard)：key 先按哈希落到 ShardCount 个分片之一，每个分片一把读写锁，
+//     不同分片上的查找/插入互不干扰；命中路径只拿读锁，可以多核并行。
+//   - 至多构造一次：未命中时在该分片的写锁内复查并调用 factory，同一个 key
+//     在对象存活期间只会被构造一次。
+//   - 惰性清理：过期条目不会主动删除，而是在分片条目数超过阈值时顺手清扫一遍，
+//     阈值随后翻倍为存活条目数的 2 倍，均摊到每次插入是 O(1)。
+template <typename K, typename T, typename Hash = std::hash<K>, size_t ShardCount = 16>
+class WeakValueCache {
+    static_assert(ShardCount > 0, "WeakValueCache needs at least one shard");
+public:
+    WeakValueCache() = default;
+    WeakValueCache(const WeakValueCache&) = delete;
+    WeakValueCache& operator=(const WeakValueCache&) = delete;
+
+    // 只查不建：命中且对象仍存活时返回强引用，否则返回空指针
+    MySharedPtr<T> get(const K& key) const {
+        const Shard& shard = shard_for(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end())
+            return MySharedPtr<T>();
+        return it->second.lock();
+    }
+
+    // factory 的签名为 MySharedPtr<T>()，只在 key 不存在或已过期时被调用
+    template <typename Factory>
+    MySharedPtr<T> get_or_create(const K& key, Factory&& factory) {
+        Shard& shard = shard_for(key);
+        {
+            // 快路径：读锁 + lock()，不修改任何共享结构
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.map.find(key);
+            if (it != shard.map.end()) {
+                MySharedPtr<T> hit = it->second.lock();
+                if (hit)
+                    return hit;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // 双重检查：等写锁期间可能已有其他线程构造好了
+        auto it = shard.map.find(key);
+        if (it != shard.map.end()) {
+            MySharedPtr<T> hit = it->second.lock();
+            if (hit)
+                return hit;
+            MySharedPtr<T> created = factory();
+            it->second = MyWeakPtr<T>(created);
+            return created;
+        }
+
+        MySharedPtr<T> created = factory();
+        shard.map.emplace(key, MyWeakPtr<T>(created));
+        if (shard.map.size() >= shard.sweep_threshold) {
+            sweep_locked(shard);
+            shard.sweep_threshold = std::max(kMinSweepThreshold, shard.map.size() * 2);
+        }
+        return created;
+    }
+
+    // 立即清扫所有分片中的过期条目，返回删除的条目数
+    size_t sweep() {
+        size_t removed = 0;
+        for (Shard& shard : _shards) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            removed += sweep_locked(shard);
+        }
+        return removed;
+    }
+
+    // 条目总数（包含尚未被清扫的过期条目）
+    size_t size() const {
+        size_t n = 0;
+        for (const Shard& shard : _shards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            n += shard.map.size();
+        }
+        return n;
+    }
+
+private:
+    static constexpr size_t kMinSweepThreshold = 64;
+
+    // 每个分片独占缓存行，避免相邻分片的锁互相伪共享
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<K, MyWeakPtr<T>, Hash> map;
+        size_t sweep_threshold = kMinSweepThreshold;
+    };
+
+    static size_t sweep_locked(Shard& shard) {
+        size_t removed = 0;
+        for (auto it = shard.map.begin(); it != shard.map.end();) {
+            if (it->second.expired()) {
+                it = shard.map.erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+        return removed;
+    }
+
+    Shard& shard_for(const K& key) {
+        return _shards[_hasher(key) % ShardCount];
+    }
+    const Shard& shard_for(const K& key) const {
+        return _shards[_hasher(key) % ShardCount];
+    }
+
+    Hash _hasher;
+    Shard _shards[ShardCount];
+};
+
+} // namespace my_std
+#endif // MY_WEAK_VALUE_CACHE_HPP
@@ -0,0 +1,339 @@
+// src/benchmark.cpp
+// 智能指针性能基准：my_std 与 std:: 的同场对比，用来评估每一次引用计数相关的改动。
+//
+// 用法：./smart_ptr_benchmark [最大线程数] [每线程操作次数]
+//   线程数按 1, 2, 4, ... 递增到最大线程数（默认 hardware_concurrency）。
+//   ns/op 为“墙钟时间 / 每线程操作次数”，即每个线程看到的单次操作延迟；
+//   完美扩展时该值不随线程数变化，争用越严重增长越快。
+//   cache-miss/op 来自 Linux perf_event（硬件 cache-misses 事件），
+//   平台或权限不支持时显示为 "-"。
+#include "../include/my_cow_ptr.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 防止编译器把被测代码整个优化掉
+template <typename T>
+static inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// ====================================================================================
+//                                  cache-miss 计数器
+// ====================================================================================
+// inherit=1：在创建工作线程之前打开，之后创建的线程自动继承该计数器，
+// 线程退出时其计数累加回来，因此 join 之后读到的是所有线程的总和。
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (_fd >= 0) close(_fd);
+#endif
+    }
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    void start() {
+#ifdef __linux__
+        if (_fd < 0) return;
+        ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // 返回计数值；不可用时返回 -1
+    long long stop() {
+#ifdef __linux__
+        if (_fd < 0) return -1;
+        ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (read(_fd, &value, sizeof(value)) != sizeof(value)) return -1;
+        return value;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    int _fd = -1;
+};
+
+// ====================================================================================
+//                                  多线程计时框架
+// ====================================================================================
+struct Result {
+    double ns_per_op;
+    double misses_per_op; // < 0 表示不可用
+};
+
+// body(thread_index, ops)：每个线程执行 ops 次操作
+template <typename Body>
+static Result RunThreads(size_t nthreads, size_t ops, Body body) {
+    CacheMissCounter counter; // 必须先于线程创建打开
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nthreads; ++t) {
+        threads.emplace_back([&, t]() {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {}
+            body(t, ops);
+        });
+    }
+    while (ready.load() != nthreads) {}
+
+    counter.start();
+    auto begin = std::chrono::high_resolution_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& th : threads) th.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    long long misses = counter.stop();
+
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    double total_ops = static_cast<double>(ops) * nthreads;
+    return {ns / ops, misses < 0 ? -1.0 : misses / total_ops};
+}
+
+static void Report(const char* bench, const char* impl, size_t nthreads, const Result& r) {
+    char misses[32];
+    if (r.misses_per_op < 0)
+        snprintf(misses, sizeof(misses), "-");
+    else
+        snprintf(misses, sizeof(misses), "%.3f", r.misses_per_op);
+    printf("%-18s %-7s %3zu 线程 %10.2f ns/op %10s cache-miss/op\n", bench, impl, nthreads,
+           r.ns_per_op, misses);
+}
+
+// ====================================================================================
+//                                  被测实现
+// ====================================================================================
+// 两边都用 new 出来的裸指针构造，控制块都单独分配，保证对比公平
+struct MyPtrs {
+    static const char* name() { return "my_std"; }
+    template <typename T> using Shared = my_std::MySharedPtr<T>;
+    template <typename T> using Weak = my_std::MyWeakPtr<T>;
+};
+
+struct StdPtrs {
+    static const char* name() { return "std"; }
+    template <typename T> using Shared = std::shared_ptr<T>;
+    template <typename T> using Weak = std::weak_ptr<T>;
+};
+
+struct Payload {
+    long value[4] = {1, 2, 3, 4};
+};
+
+template <typename P>
+struct TreeNode {
+    typename P::template Shared<TreeNode> left;
+    typename P::template Shared<TreeNode> right;
+    typename P::template Weak<TreeNode> parent;
+};
+
+template <typename P>
+static typename P::template Shared<TreeNode<P>> BuildTree(int depth) {
+    typename P::template Shared<TreeNode<P>> node(new TreeNode<P>);
+    if (depth > 1) {
+        node->left = BuildTree<P>(depth - 1);
+        node->right = BuildTree<P>(depth - 1);
+        node->left->parent = node;
+        node->right->parent = node;
+    }
+    return node;
+}
+
+template <typename P>
+static void RunSuite(size_t nthreads, size_t ops) {
+    using Shared = typename P::template Shared<Payload>;
+    using Weak = typename P::template Weak<Payload>;
+
+    Report("construct+destroy", P::name(), nthreads, RunThreads(nthreads, ops, [](size_t, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            Shared p(new Payload);
+            DoNotOptimize(p);
+        }
+    }));
+
+    // 每个线程拷贝自己的指针：无共享，测单纯的计数开销
+    Report("copy", P::name(), nthreads, RunThreads(nthreads, ops, [](size_t, size_t n) {
+        Shared src(new Payload);
+        for (size_t i = 0; i < n; ++i) {
+            Shared copy = src;
+            DoNotOptimize(copy);
+        }
+    }));
+
+    Report("move", P::name(), nthreads, RunThreads(nthreads, ops, [](size_t, size_t n) {
+        Shared a(new Payload);
+        for (size_t i = 0; i < n; ++i) {
+            Shared b = std::move(a);
+            a = std::move(b);
+            DoNotOptimize(a);
+        }
+    }));
+
+    Report("weak.lock", P::name(), nthreads, RunThreads(nthreads, ops, [](size_t, size_t n) {
+        Shared owner(new Payload);
+        Weak weak = owner;
+        for (size_t i = 0; i < n; ++i) {
+            Shared locked = weak.lock();
+            DoNotOptimize(locked);
+        }
+    }));
+
+    // 所有线程拷贝同一个指针：同一条缓存行上的计数被反复争抢
+    {
+        Shared shared(new Payload);
+        Report("contended copy", P::name(), nthreads, RunThreads(nthreads, ops, [&shared](size_t, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                Shared copy = shared;
+                DoNotOptimize(copy);
+            }
+        }));
+        Weak weak = shared;
+        Report("contended lock", P::name(), nthreads, RunThreads(nthreads, ops, [&weak](size_t, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                Shared locked = weak.lock();
+                DoNotOptimize(locked);
+            }
+        }));
+    }
+
+    // 图析构：只计整棵带 parent 弱引用的满二叉树的释放，ns/op 按节点计。
+    // 每批先在计时外为每个线程建好 kBatchTrees 棵树，计时部分只有 reset()；分批是为了控制内存占用
+    const int depth = 12;
+    const size_t nodes = (size_t(1) << depth) - 1;
+    const size_t rounds = ops / nodes > 0 ? ops / nodes : 1;
+    const size_t kBatchTrees = 32;
+    std::vector<std::vector<typename P::template Shared<TreeNode<P>>>> forests(nthreads);
+    Result teardown{0, 0};
+    for (size_t done = 0; done < rounds;) {
+        size_t batch = rounds - done < kBatchTrees ? rounds - done : kBatchTrees;
+        for (auto& forest : forests) {
+            forest.clear();
+            for (size_t i = 0; i < batch; ++i) forest.push_back(BuildTree<P>(depth));
+        }
+        Result r = RunThreads(nthreads, batch, [&forests](size_t t, size_t n) {
+            for (size_t i = 0; i < n; ++i) forests[t][i].reset();
+        });
+        // RunThreads 的结果是“每棵树”的均值，按棵数加权累加
+        teardown.ns_per_op += r.ns_per_op * batch;
+        if (r.misses_per_op < 0 || teardown.misses_per_op < 0)
+            teardown.misses_per_op = -1;
+        else
+            teardown.misses_per_op += r.misses_per_op * batch;
+        done += batch;
+    }
+    teardown.ns_per_op /= double(rounds) * nodes;
+    if (teardown.misses_per_op >= 0) teardown.misses_per_op /= double(rounds) * nodes;
+    Report("graph teardown", P::name(), nthreads, teardown);
+}
+
+// ====================================================================================
+//                                  MyCowPtr vs 按值拷贝
+// ====================================================================================
+// 一个“大”的只读配置结构：拷贝一次需要深拷贝 map 和 vector
+struct Config {
+    std::map<std::string, std::string> entries;
+    std::vector<double> weights;
+
+    Config() {
+        for (int i = 0; i < 256; ++i)
+            entries["key_" + std::to_string(i)] = "value_" + std::to_string(i);
+        weights.assign(4096, 1.0);
+    }
+};
+
+static volatile double g_sink = 0;
+
+// 模拟业务函数：按值接收配置，只读取其中一部分
+static double ReadEager(Config cfg) { return cfg.weights[7] + cfg.entries.size(); }
+static double ReadCow(my_std::MyCowPtr<Config> cfg) { return cfg->weights[7] + cfg->entries.size(); }
+
+template <typename F>
+static double NsPerOp(size_t ntimes, F&& f) {
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < ntimes; ++i) f(i);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / ntimes;
+}
+
+// write_every: 每多少次调用做一次修改（0 表示只读）
+void BenchmarkCow(size_t ntimes, size_t write_every) {
+    Config eager;
+    double eager_ns = NsPerOp(ntimes, [&](size_t i) {
+        g_sink = g_sink + ReadEager(eager);
+        if (write_every && i % write_every == 0) {
+            Config copy = eager; // 防御性拷贝后再改
+            copy.weights[i % copy.weights.size()] += 1;
+            eager = std::move(copy);
+        }
+    });
+
+    auto cow = my_std::MyCowPtr<Config>::make();
+    double cow_ns = NsPerOp(ntimes, [&](size_t i) {
+        g_sink = g_sink + ReadCow(cow);
+        if (write_every && i % write_every == 0) {
+            my_std::MyCowPtr<Config> copy = cow;
+            copy.write().weights[i % copy->weights.size()] += 1; // 共享 -> 克隆
+            cow = std::move(copy);
+        }
+    });
+
+    printf("[CowPtr] 调用 %zu 次, 写入间隔 %zu (0=只读): 按值拷贝 %.1f ns/op, MyCowPtr %.1f ns/op (%.1fx)\n",
+           ntimes, write_every, eager_ns, cow_ns, eager_ns / cow_ns);
+}
+
+int main(int argc, char** argv) {
+    size_t max_threads = std::thread::hardware_concurrency();
+    if (argc > 1) max_threads = std::strtoul(argv[1], nullptr, 10);
+    if (max_threads == 0) max_threads = 1;
+    size_t ops = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+    for (size_t n = 1; n <= max_threads; n *= 2) {
+        RunSuite<MyPtrs>(n, ops);
+        RunSuite<StdPtrs>(n, ops);
+        printf("------------------------------------------------\n");
+    }
+
+    BenchmarkCow(20000, 0);
+    BenchmarkCow(20000, 100);
+    BenchmarkCow(20000, 10);
+    return 0;
+}
+
+/*
+--- COMPILE AND RUN ---
+g++ -O2 -std=c++17 -pthread -I./include src/benchmark.cpp -o smart_ptr_benchmark
+./smart_ptr_benchmark 8 1000000
+
+在容器或未开放 perf 的系统上，可能需要：
+sudo sysctl kernel.perf_event_paranoid=1
+*/
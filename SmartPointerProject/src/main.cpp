@@ -1,8 +1,18 @@
 // src/main.cpp
+#define MY_SMART_PTR_STATS // 测试程序开启按类型统计（NDEBUG 下自动失效）
+#define MY_PTR_BORROW_CHECK // 测试程序开启 MyBorrowPtr 的借用检查
 #include "../include/my_smart_ptr.hpp" // 假设你的头文件路径
+#include "../include/my_weak_value_cache.hpp"
+#include "../include/my_cow_ptr.hpp"
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <typeinfo>
 #include <utility> // for std::move
+#include <vector>
 
 // 用于打印构造/析构日志的测试类
 struct TestClass {
@@ -34,6 +44,21 @@ public:
         test_weak_ptr_lock_and_expired();
         test_weak_ptr_copy_and_move(); // 新增的 weak_ptr 拷贝与移动测试
         test_circular_reference_break();
+        test_weak_ptr_concurrent_lock();
+
+        std::cout << "\n===== Running WeakValueCache Tests =====" << std::endl;
+        test_weak_value_cache_dedup_and_sweep();
+        test_weak_value_cache_concurrent_create();
+
+        std::cout << "\n===== Running MyCowPtr Tests =====" << std::endl;
+        test_cow_ptr_copy_on_write();
+        test_cow_ptr_concurrent_write();
+
+        std::cout << "\n===== Running MyBorrowPtr Tests =====" << std::endl;
+        test_borrow_ptr_no_refcount();
+
+        std::cout << "\n===== Running ptr_stats Tests =====" << std::endl;
+        test_ptr_stats_accounting();
         
         std::cout << "\n======================================" << std::endl;
         std::cout << "  All smart pointer tests passed!" << std::endl;
@@ -279,6 +304,198 @@ private:
         }
         // CHECK: Verify that TestClass 20 and 21 destructors are both called.
     }
+
+    // [NEW] - 原子计数：多个线程同时 lock()/释放，与最后一个强引用的析构竞争
+    void test_weak_ptr_concurrent_lock() {
+        std::cout << "\n--- Test: WeakPtr Concurrent lock() ---" << std::endl;
+        for (int round = 0; round < 100; ++round) {
+            my_std::MySharedPtr<int> sp(new int(round));
+            my_std::MyWeakPtr<int> wp = sp;
+            std::atomic<bool> go{false};
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&go, wp]() {
+                    while (!go.load()) {}
+                    for (int i = 0; i < 1000; ++i) {
+                        auto locked = wp.lock();
+                        if (locked) assert(*locked >= 0);
+                    }
+                });
+            }
+            go.store(true);
+            sp.reset(); // 与 lock() 竞争：对象只能被 delete 一次
+            for (auto& th : threads) th.join();
+            assert(wp.expired());
+        }
+    }
+
+    // [NEW] - WeakValueCache：同 key 去重、对象释放后重建、惰性清扫
+    void test_weak_value_cache_dedup_and_sweep() {
+        std::cout << "\n--- Test: WeakValueCache Dedup & Sweep ---" << std::endl;
+        my_std::WeakValueCache<int, std::string> cache;
+        int created = 0;
+        auto make = [&created]() {
+            ++created;
+            return my_std::MySharedPtr<std::string>(new std::string("schema"));
+        };
+
+        auto a = cache.get_or_create(1, make);
+        auto b = cache.get_or_create(1, make);
+        assert(created == 1 && "Live key must not be constructed twice");
+        assert(a.get() == b.get());
+        assert(cache.get(1).get() == a.get());
+        assert(!cache.get(2) && "Missing key should yield an empty pointer");
+
+        a.reset();
+        b.reset();
+        assert(!cache.get(1) && "Expired entry should not be returned");
+        auto c = cache.get_or_create(1, make);
+        assert(created == 2 && "Expired entry should be rebuilt");
+
+        for (int k = 100; k < 10100; ++k) cache.get_or_create(k, make);
+        // 临时对象都已释放，惰性清扫使每个分片的条目数维持在阈值附近，不随插入无限增长
+        assert(cache.size() <= 16 * 64);
+        cache.sweep();
+        assert(cache.size() == 1 && "Only the live key 1 should survive sweep()");
+    }
+
+    // [NEW] - WeakValueCache：多线程竞争同一批 key，每个 key 只构造一次
+    void test_weak_value_cache_concurrent_create() {
+        std::cout << "\n--- Test: WeakValueCache Concurrent get_or_create ---" << std::endl;
+        my_std::WeakValueCache<int, int> cache;
+        std::atomic<int> created{0};
+        const int kKeys = 64;
+        std::vector<my_std::MySharedPtr<int>> pinned[4];
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int k = 0; k < kKeys; ++k) {
+                    pinned[t].push_back(cache.get_or_create(k, [&created, k]() {
+                        created.fetch_add(1);
+                        return my_std::MySharedPtr<int>(new int(k));
+                    }));
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        assert(created.load() == kKeys && "Each key must be constructed at most once");
+        for (int k = 0; k < kKeys; ++k) {
+            for (int t = 1; t < 4; ++t)
+                assert(pinned[t][k].get() == pinned[0][k].get());
+            assert(pinned[0][k].use_count() == 4);
+        }
+    }
+
+    // [NEW] - MyCowPtr：拷贝共享同一对象，write() 只在共享时克隆
+    void test_cow_ptr_copy_on_write() {
+        std::cout << "\n--- Test: CowPtr Copy-On-Write ---" << std::endl;
+        auto a = my_std::MyCowPtr<std::vector<int>>::make(3, 7);
+        const std::vector<int>* original = a.get();
+        assert(a.unique());
+
+        a.write()[0] = 1; // 独占时原地修改
+        assert(a.get() == original && "Unique owner must not clone");
+
+        my_std::MyCowPtr<std::vector<int>> b = a;
+        assert(b.get() == original && a.use_count() == 2 && "Copies share the object");
+
+        b.write()[1] = 2; // 共享时克隆
+        assert(b.get() != original && "Shared write must clone");
+        assert(a.unique() && b.unique());
+        assert((*a)[0] == 1 && (*a)[1] == 7 && "Original must be untouched");
+        assert((*b)[0] == 1 && (*b)[1] == 2);
+
+        my_std::MyCowPtr<std::vector<int>> empty;
+        assert(!empty && empty.use_count() == 0);
+    }
+
+    // [NEW] - MyCowPtr：多个线程各自持有副本并写入，互不影响
+    void test_cow_ptr_concurrent_write() {
+        std::cout << "\n--- Test: CowPtr Concurrent write() ---" << std::endl;
+        auto shared = my_std::MyCowPtr<std::vector<int>>::make(64, 0);
+        std::vector<std::thread> threads;
+        for (int t = 1; t <= 4; ++t) {
+            threads.emplace_back([shared, t]() mutable {
+                for (int i = 0; i < 1000; ++i) {
+                    auto& v = shared.write();
+                    v[i % 64] = t;
+                    assert(shared.unique());
+                }
+                for (int x : *shared) assert(x == t || x == 0);
+            });
+        }
+        for (auto& th : threads) th.join();
+        for (int x : *shared) assert(x == 0 && "Readers' copy must never observe writes");
+    }
+
+    // 借用参数：按值传递 MyBorrowPtr 不应改变 use_count
+    static int borrowed_id(my_std::MyBorrowPtr<TestClass> p, int expected_use_count,
+                           const my_std::MySharedPtr<TestClass>* owner) {
+        if (owner) assert(owner->use_count() == expected_use_count);
+        return p->id;
+    }
+
+    // [NEW] - MyBorrowPtr：从 MySharedPtr / MyUniquePtr 借用，不产生计数流量
+    void test_borrow_ptr_no_refcount() {
+        std::cout << "\n--- Test: BorrowPtr Without Refcount Traffic ---" << std::endl;
+        my_std::MySharedPtr<TestClass> sp(new TestClass(22));
+        assert(borrowed_id(sp, 1, &sp) == 22 && "Borrowing must not touch use_count");
+
+        my_std::MyBorrowPtr<TestClass> b1 = sp;
+        my_std::MyBorrowPtr<TestClass> b2 = b1;
+        b1 = b2;
+        assert(b1.get() == sp.get() && b2->id == 22);
+        assert(sp.use_count() == 1);
+        my_std::MyWeakPtr<TestClass> wp = sp;
+        b1 = my_std::MyBorrowPtr<TestClass>();
+        b2 = my_std::MyBorrowPtr<TestClass>();
+        sp.reset(); // 借用已全部结束，对象可以正常析构
+        assert(wp.expired());
+
+        my_std::MyUniquePtr<TestClass> up(new TestClass(23));
+        assert(borrowed_id(up, 0, nullptr) == 23);
+        my_std::MyBorrowPtr<TestClass> empty;
+        assert(!empty);
+    }
+
+    struct StatsProbe { char payload[40]; };
+
+    static my_std::ptr_stats::TypeStats probe_stats() {
+        for (const auto& s : my_std::ptr_stats::snapshot())
+            if (s.type_name == typeid(StatsProbe).name()) return s;
+        return my_std::ptr_stats::TypeStats();
+    }
+
+    // [NEW] - ptr_stats：存活对象、控制块、弱引用滞留块的计数，以及跨线程释放
+    void test_ptr_stats_accounting() {
+        std::cout << "\n--- Test: ptr_stats Accounting ---" << std::endl;
+#ifdef MY_SMART_PTR_STATS_ENABLED
+        {
+            my_std::MySharedPtr<StatsProbe> a(new StatsProbe);
+            my_std::MySharedPtr<StatsProbe> b(new StatsProbe);
+            my_std::MyWeakPtr<StatsProbe> wb = b;
+            auto s = probe_stats();
+            assert(s.live_objects == 2 && s.live_blocks == 2 && s.weak_only_blocks == 0);
+            assert(s.bytes == 2 * (long long)(sizeof(StatsProbe) + sizeof(my_std::ControlBlock)));
+
+            b.reset(); // 对象析构，控制块被 wb 留住
+            s = probe_stats();
+            assert(s.live_objects == 1 && s.live_blocks == 2 && s.weak_only_blocks == 1);
+
+            // 在另一个线程释放：计数落在不同分片，求和后仍然正确
+            std::thread([&a]() { a.reset(); }).join();
+            wb = my_std::MyWeakPtr<StatsProbe>();
+        }
+        auto s = probe_stats();
+        assert(s.live_objects == 0 && s.live_blocks == 0 && s.weak_only_blocks == 0 && s.bytes == 0);
+
+        std::ostringstream out;
+        my_std::ptr_stats::dump(out);
+        assert(out.str().find(typeid(StatsProbe).name()) != std::string::npos);
+#else
+        assert(my_std::ptr_stats::snapshot().empty() && "Stats must be compiled out");
+#endif
+    }
 };
 
 int main() {
@@ -295,7 +512,7 @@ double-frees, or use-after-frees, compile with AddressSanitizer and
 UndefinedBehaviorSanitizer.
 
 Example command (GCC/Clang):
-g++ -g -std=c++11 -fsanitize=address,undefined -I./include src/main.cpp -o smart_ptr_test
+g++ -g -std=c++17 -pthread -fsanitize=address,undefined -I./include src/main.cpp -o smart_ptr_test
 
 Then run the compiled executable:
 ./smart_ptr_test
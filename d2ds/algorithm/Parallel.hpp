@@ -0,0 +1,285 @@
+#ifndef PARALLEL_HPP_D2DS
+#define PARALLEL_HPP_D2DS
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algorithm/ThreadPool.hpp"
+#include "common/common.hpp"
+#include "common/simd.hpp"
+
+namespace d2ds {
+namespace parallel {
+
+// 并行算法：parallel_for / transform / reduce / sort / inclusive_scan
+//
+// 适用于随机访问迭代器（d2ds::Vector / Array 的 begin()/end() 就是裸指针）。
+// 区间被切成若干连续块（块数约为线程数的 4 倍，每块不少于 kMinChunk 个元素），
+// 块作为任务提交给工作窃取线程池，调用线程自己也处理第一块并在等待时帮忙执行其他块。
+// 每个算法都有两个版本：第一个参数为 ThreadPool& 的版本跑在指定线程池上，
+// 不带线程池的版本使用 ThreadPool::shared()。
+//
+// 与 <algorithm> 的区别：
+//   - reduce / inclusive_scan 要求 op 满足结合律（块内、块间分别结合）；
+//   - sort 不稳定；
+//   - 元素函数抛出的异常会在所有块结束后重新抛给调用者（只保留第一个）。
+
+constexpr size_t kMinChunk = 2048;
+
+namespace detail {
+
+inline size_t chunk_count(const ThreadPool& pool, size_t n, size_t min_chunk = kMinChunk) {
+    size_t threads = pool.size() + 1;
+    if (threads == 1 || n <= min_chunk) return n == 0 ? 0 : 1;
+    return std::min(threads * 4, (n + min_chunk - 1) / min_chunk);
+}
+
+inline size_t chunk_begin(size_t n, size_t chunks, size_t c) {
+    return n * c / chunks;
+}
+
+// 对每一块调用 f(c, begin, end)；第 0 块在调用线程上执行
+template<typename F>
+void for_chunks(ThreadPool& pool, size_t n, size_t chunks, const F& f) {
+    if (chunks == 0) return;
+    if (chunks == 1) {
+        f(size_t(0), size_t(0), n);
+        return;
+    }
+    TaskGroup group(pool);
+    for (size_t c = 1; c < chunks; ++c)
+        group.run([&f, n, chunks, c] { f(c, chunk_begin(n, chunks, c), chunk_begin(n, chunks, c + 1)); });
+    f(size_t(0), size_t(0), chunk_begin(n, chunks, 1));
+    group.wait();
+}
+
+// simd::sum 在元素类型里累加，只有累加类型 T 与元素类型相同时才等价；
+// reduce(int*, ..., 0LL) 这类拓宽求和要走标量路径，在 T 里累加以免溢出
+template<typename It, typename T, typename Op>
+struct use_simd_sum
+    : std::integral_constant<bool,
+                             std::is_pointer<It>::value &&
+                                 simd::is_vectorizable<typename std::iterator_traits<It>::value_type>::value &&
+                                 std::is_same<T, typename std::iterator_traits<It>::value_type>::value &&
+                                 (std::is_same<Op, std::plus<>>::value ||
+                                  std::is_same<Op, std::plus<typename std::iterator_traits<It>::value_type>>::value)> {};
+
+// 把有序区间 [a0,a1) 与 [b0,b1) 归并（移动）到 out：
+// 较长一侧取中点，在另一侧二分找到分割位置，左右两半互不相干，可以并行归并
+template<typename It, typename Out, typename Comp>
+void merge_move(ThreadPool& pool, It a0, It a1, It b0, It b1, Out out, const Comp& comp) {
+    size_t na = size_t(a1 - a0), nb = size_t(b1 - b0);
+    if (na + nb <= 4 * kMinChunk || pool.size() == 0) {
+        std::merge(std::make_move_iterator(a0), std::make_move_iterator(a1), std::make_move_iterator(b0),
+                   std::make_move_iterator(b1), out, comp);
+        return;
+    }
+    if (na < nb) { // sort 不要求稳定，交换两侧不影响正确性
+        std::swap(a0, b0);
+        std::swap(a1, b1);
+        std::swap(na, nb);
+    }
+    It am = a0 + na / 2;
+    It bm = std::lower_bound(b0, b1, *am, comp);
+    Out out_mid = out + (am - a0) + (bm - b0);
+    TaskGroup group(pool);
+    group.run([&] { merge_move(pool, a0, am, b0, bm, out, comp); });
+    merge_move(pool, am, a1, bm, b1, out_mid, comp);
+    group.wait();
+}
+
+} // namespace detail
+
+// ---- parallel_for：对区间内每个元素调用 f(*it) ----
+
+template<typename It, typename F>
+void parallel_for(ThreadPool& pool, It first, It last, F f) {
+    size_t n = size_t(last - first);
+    detail::for_chunks(pool, n, detail::chunk_count(pool, n), [&](size_t, size_t b, size_t e) {
+        for (It it = first + b, end = first + e; it != end; ++it)
+            f(*it);
+    });
+}
+
+template<typename It, typename F>
+void parallel_for(It first, It last, F f) {
+    parallel_for(ThreadPool::shared(), first, last, std::move(f));
+}
+
+// ---- transform：out[i] = f(in[i]) / out[i] = f(in1[i], in2[i])；out 可以与输入相同 ----
+
+template<typename It, typename Out, typename F>
+Out transform(ThreadPool& pool, It first, It last, Out out, F f) {
+    size_t n = size_t(last - first);
+    detail::for_chunks(pool, n, detail::chunk_count(pool, n), [&](size_t, size_t b, size_t e) {
+        std::transform(first + b, first + e, out + b, f);
+    });
+    return out + n;
+}
+
+template<typename It, typename Out, typename F>
+Out transform(It first, It last, Out out, F f) {
+    return transform(ThreadPool::shared(), first, last, out, std::move(f));
+}
+
+template<typename It1, typename It2, typename Out, typename F>
+Out transform(ThreadPool& pool, It1 first1, It1 last1, It2 first2, Out out, F f) {
+    size_t n = size_t(last1 - first1);
+    detail::for_chunks(pool, n, detail::chunk_count(pool, n), [&](size_t, size_t b, size_t e) {
+        std::transform(first1 + b, first1 + e, first2 + b, out + b, f);
+    });
+    return out + n;
+}
+
+template<typename It1, typename It2, typename Out, typename F>
+Out transform(It1 first1, It1 last1, It2 first2, Out out, F f) {
+    return transform(ThreadPool::shared(), first1, last1, first2, out, std::move(f));
+}
+
+// ---- reduce：init op x0 op x1 ...，op 需满足结合律 ----
+// 裸指针 + 算术类型 + std::plus、且 init 与元素同类型时每块直接用 simd::sum
+
+template<typename It, typename T, typename Op = std::plus<>>
+T reduce(ThreadPool& pool, It first, It last, T init, Op op = Op()) {
+    size_t n = size_t(last - first);
+    size_t chunks = detail::chunk_count(pool, n);
+    if (chunks == 0) return init;
+
+    std::vector<T> partial(chunks, init);
+    detail::for_chunks(pool, n, chunks, [&](size_t c, size_t b, size_t e) {
+        if constexpr (detail::use_simd_sum<It, T, Op>::value) {
+            partial[c] = simd::sum(first + b, e - b);
+        } else {
+            T acc = first[b];
+            for (size_t i = b + 1; i < e; ++i)
+                acc = op(std::move(acc), first[i]);
+            partial[c] = std::move(acc);
+        }
+    });
+    T result = std::move(init);
+    for (size_t c = 0; c < chunks; ++c)
+        result = op(std::move(result), std::move(partial[c]));
+    return result;
+}
+
+template<typename It, typename T, typename Op = std::plus<>>
+T reduce(It first, It last, T init, Op op = Op()) {
+    return reduce(ThreadPool::shared(), first, last, std::move(init), std::move(op));
+}
+
+// ---- inclusive_scan：out[i] = x0 op x1 op ... op xi；out 可以与输入相同 ----
+// 两遍扫描：先并行求每块的和，串行算出每块的前缀偏移，再并行做带偏移的块内扫描
+
+template<typename It, typename Out, typename Op = std::plus<>>
+Out inclusive_scan(ThreadPool& pool, It first, It last, Out out, Op op = Op()) {
+    using V = typename std::iterator_traits<It>::value_type;
+    size_t n = size_t(last - first);
+    size_t chunks = detail::chunk_count(pool, n);
+    if (chunks <= 1) {
+        if (n != 0) std::partial_sum(first, last, out, op);
+        return out + n;
+    }
+
+    std::vector<std::optional<V>> sums(chunks);
+    // 最后一块的和用不到，不算
+    detail::for_chunks(pool, n, chunks - 1, [&](size_t c, size_t, size_t) {
+        size_t b = detail::chunk_begin(n, chunks, c), e = detail::chunk_begin(n, chunks, c + 1);
+        V acc = first[b];
+        for (size_t i = b + 1; i < e; ++i)
+            acc = op(std::move(acc), first[i]);
+        sums[c].emplace(std::move(acc));
+    });
+    for (size_t c = 1; c + 1 < chunks; ++c)
+        sums[c].emplace(op(*sums[c - 1], std::move(*sums[c])));
+
+    detail::for_chunks(pool, n, chunks, [&](size_t c, size_t b, size_t e) {
+        V acc = c == 0 ? V(first[b]) : op(*sums[c - 1], first[b]);
+        out[b] = acc;
+        for (size_t i = b + 1; i < e; ++i) {
+            acc = op(std::move(acc), first[i]);
+            out[i] = acc;
+        }
+    });
+    return out + n;
+}
+
+template<typename It, typename Out, typename Op = std::plus<>>
+Out inclusive_scan(It first, It last, Out out, Op op = Op()) {
+    return inclusive_scan(ThreadPool::shared(), first, last, out, std::move(op));
+}
+
+// ---- sort：各块并行 std::sort，再两两并行归并（在原区间与同样大小的缓冲区之间来回搬） ----
+
+template<typename It, typename Comp = std::less<>>
+void sort(ThreadPool& pool, It first, It last, Comp comp = Comp()) {
+    using V = typename std::iterator_traits<It>::value_type;
+    size_t n = size_t(last - first);
+    size_t chunks = detail::chunk_count(pool, n, 4 * kMinChunk);
+    if (chunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    detail::for_chunks(pool, n, chunks, [&](size_t, size_t b, size_t e) { std::sort(first + b, first + e, comp); });
+
+    // 缓冲区：未初始化内存，把排好序的各块整体移动构造过去，第一轮从缓冲区归并回原区间
+    struct Buffer {
+        V* data;
+        size_t size, capacity;
+        explicit Buffer(size_t n)
+            : data(static_cast<V*>(DefaultAllocator::allocate(sizeof(V) * n))), size(0), capacity(n) {
+            if (data == nullptr) throw std::bad_alloc();
+        }
+        ~Buffer() {
+            std::destroy(data, data + size);
+            DefaultAllocator::deallocate(data, sizeof(V) * capacity);
+        }
+    } buffer(n);
+    std::uninitialized_move(first, last, buffer.data);
+    buffer.size = n;
+
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; ++c)
+        bounds[c] = detail::chunk_begin(n, chunks, c);
+
+    bool in_buffer = true; // 当前有序的数据在哪一边
+    while (bounds.size() > 2) {
+        std::vector<size_t> next;
+        TaskGroup group(pool);
+        for (size_t k = 0; k + 1 < bounds.size(); k += 2) {
+            size_t b = bounds[k], m = bounds[k + 1];
+            size_t e = k + 2 < bounds.size() ? bounds[k + 2] : m;
+            next.push_back(b);
+            group.run([&, b, m, e] {
+                if (in_buffer)
+                    detail::merge_move(pool, buffer.data + b, buffer.data + m, buffer.data + m, buffer.data + e, first + b, comp);
+                else
+                    detail::merge_move(pool, first + b, first + m, first + m, first + e, buffer.data + b, comp);
+            });
+        }
+        next.push_back(n);
+        group.wait();
+        bounds.swap(next);
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer)
+        parallel::transform(pool, buffer.data, buffer.data + n, first, [](V& x) { return std::move(x); });
+}
+
+template<typename It, typename Comp = std::less<>>
+void sort(It first, It last, Comp comp = Comp()) {
+    sort(ThreadPool::shared(), first, last, std::move(comp));
+}
+
+} // namespace parallel
+} // namespace d2ds
+
+#endif
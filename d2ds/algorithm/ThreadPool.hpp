@@ -0,0 +1,198 @@
+#ifndef THREAD_POOL_HPP_D2DS
+#define THREAD_POOL_HPP_D2DS
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace d2ds {
+
+// 工作窃取线程池：
+//   - 每个工作线程一个双端队列，自己从尾部取（LIFO，刚拆出来的任务数据还在缓存里），
+//     空闲时从其他线程队列的头部偷（FIFO，偷走的往往是较大的一块）；
+//   - 池外线程提交的任务轮流放进各个队列；池内线程提交的任务放进自己的队列；
+//   - 等待任务完成的线程不睡眠，而是调用 try_run_one() 一起干活，
+//     因此嵌套并行（任务里再调 parallel_for）不会因为线程都在等待而死锁。
+// 队列用互斥锁保护：每个任务是一整块数据，锁的开销相对任务本身可以忽略。
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // workers 为后台线程数；调用者自己也会参与执行，所以默认比核数少 1
+    explicit ThreadPool(unsigned int workers = default_workers())
+        : _queues(workers == 0 ? 1 : workers) {
+        for (unsigned int i = 0; i < workers; ++i)
+            _threads.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _stop = true;
+        }
+        _wakeup.notify_all();
+        for (auto& t : _threads) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 进程内共享的默认线程池
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    static unsigned int default_workers() {
+        unsigned int n = std::thread::hardware_concurrency();
+        return n > 1 ? n - 1 : 0;
+    }
+
+    // 后台线程数（不含调用者）
+    unsigned int size() const { return static_cast<unsigned int>(_threads.size()); }
+
+    void submit(Task task) {
+        unsigned int index = (t_current_pool == this) ? t_current_index
+                                                       : _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+        {
+            std::lock_guard<std::mutex> lock(_queues[index].mutex);
+            _queues[index].tasks.push_back(std::move(task));
+        }
+        _pending.fetch_add(1, std::memory_order_release);
+        // 先加计数再拿一次锁，保证不会错过正准备睡眠的线程
+        { std::lock_guard<std::mutex> lock(_sleep_mutex); }
+        _wakeup.notify_one();
+    }
+
+    // 取一个任务在当前线程执行；没有任务时返回 false
+    bool try_run_one() {
+        Task task;
+        unsigned int self = (t_current_pool == this) ? t_current_index : 0;
+        if (!pop(self, task))
+            return false;
+        task();
+        return true;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // 先看自己的队列尾部，再依次从其他队列头部偷
+    bool pop(unsigned int self, Task& task) {
+        if (_pending.load(std::memory_order_acquire) == 0)
+            return false;
+        {
+            Queue& q = _queues[self];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+                _pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for (size_t k = 1; k < _queues.size(); ++k) {
+            Queue& q = _queues[(self + k) % _queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                _pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(unsigned int index) {
+        t_current_pool = this;
+        t_current_index = index;
+        Task task;
+        while (true) {
+            if (pop(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_sleep_mutex);
+            _wakeup.wait(lock, [this] { return _stop || _pending.load(std::memory_order_acquire) > 0; });
+            if (_stop && _pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    std::vector<Queue> _queues;
+    std::vector<std::thread> _threads;
+    std::atomic<size_t> _pending{0};
+    std::atomic<unsigned int> _next_queue{0};
+    std::mutex _sleep_mutex;
+    std::condition_variable _wakeup;
+    bool _stop = false;
+
+    static thread_local ThreadPool* t_current_pool;
+    static thread_local unsigned int t_current_index;
+};
+
+inline thread_local ThreadPool* ThreadPool::t_current_pool = nullptr;
+inline thread_local unsigned int ThreadPool::t_current_index = 0;
+
+// 一组任务的完成计数：wait() 期间调用线程帮忙执行池中的任务，
+// 第一个抛出的异常会在 wait() 中重新抛出
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool): _pool(pool) {}
+
+    ~TaskGroup() {
+        // 保证所有任务结束后才销毁（任务里引用了本对象）
+        while (_remaining.load(std::memory_order_acquire) != 0)
+            help_or_yield();
+    }
+
+    template<typename F>
+    void run(F&& f) {
+        _remaining.fetch_add(1, std::memory_order_relaxed);
+        _pool.submit([this, f = std::forward<F>(f)]() mutable {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_error_mutex);
+                if (!_error) _error = std::current_exception();
+            }
+            _remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait() {
+        while (_remaining.load(std::memory_order_acquire) != 0)
+            help_or_yield();
+        if (_error) {
+            std::exception_ptr e = _error;
+            _error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    void help_or_yield() {
+        if (!_pool.try_run_one())
+            std::this_thread::yield();
+    }
+
+    ThreadPool& _pool;
+    std::atomic<size_t> _remaining{0};
+    std::mutex _error_mutex;
+    std::exception_ptr _error;
+};
+
+} // namespace d2ds
+
+#endif
@@ -2,75 +2,282 @@
 #define ARRAY_HPP_D2DS
 
 #include <initializer_list>
+#include <type_traits>
+
+#include "common/common.hpp"
+#include "common/simd.hpp"
 
 namespace d2ds {
 // show your code
-    template<typename T, unsigned int N>
+
+    namespace detail {
+        // 运行期批量运算是否走 simd 内核（运行时选 SSE2/AVX2）：
+        // 数组太短时分派开销不划算，直接写定长循环，编译器会按已知的长度和对齐展开并向量化
+        template<typename T, unsigned int N>
+        constexpr bool array_use_simd = simd::is_vectorizable<T>::value && sizeof(T) * N >= 256;
+    }
+
+    // 定长数组。Alignment 默认为 alignof(T)；取 CACHE_LINE_SIZE (64) 时存储按缓存行对齐，
+    // 定长的逐元素运算可以编译成对齐的向量加载/存储，多个数组之间也不会共享缓存行。
+    // fill / copy / 比较 / 归约 / 逐元素运算都是 constexpr：编译期求值走普通循环，运行期才用 memcpy 或 simd 内核。
+    template<typename T, unsigned int N, unsigned int Alignment = alignof(T)>
     class Array{
+        static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                      "d2ds::Array alignment must be a power of two no smaller than alignof(T)");
     public:
-        Array(std::initializer_list<T> list){
-            for(auto it = list.begin(); it != list.end() && it - list.begin() < list.size(); it++){
-                a[it - list.begin()] = *it;
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        constexpr Array(std::initializer_list<T> list): a{}{
+            unsigned int i = 0;
+            for(auto it = list.begin(); it != list.end() && i < N; it++, i++){
+                a[i] = *it;
             }
         }
 
         Array()=default;
         ~Array()=default;
-        Array(const Array& other){
-            for(int i=0;i<N;i++){
-                a[i]=other.a[i];
+        // 拷贝/移动交给编译器生成：平凡可复制的 T 整块 memcpy，Array 本身也保持平凡可复制
+        Array(const Array& other)=default;
+        Array& operator =(const Array& other)=default;
+        Array(Array && other)=default;
+        Array &operator=(Array && other)=default;
+
+        // 负下标从尾部计数：a[-1] 即最后一个元素
+        constexpr T & operator[](int index){
+            if(index<0)
+                index=index+N;
+            d2ds_assert(index>=0 && index<int(N));
+            return a[index];
+        }
+
+        constexpr const T & operator[](int index) const{
+            if(index<0)
+                index=index+N;
+            d2ds_assert(index>=0 && index<int(N));
+            return a[index];
+        }
+
+        constexpr unsigned int size() const{
+            return N;
+        }
+
+        constexpr bool empty() const{
+            return N==0;
+        }
+
+        constexpr T& front(){
+            return a[0];
+        }
+
+        constexpr const T& front() const{
+            return a[0];
+        }
+
+        constexpr T& back(){
+            return a[N==0?0:N-1];
+        }
+
+        constexpr const T& back() const{
+            return a[N==0?0:N-1];
+        }
+
+        // 以下访问方式不做边界检查
+        constexpr T* data(){
+            return a;
+        }
+
+        constexpr const T* data() const{
+            return a;
+        }
+
+        constexpr T* begin(){
+            return a;
+        }
+
+        constexpr T* end(){
+            return a+N;
+        }
+
+        constexpr const T* begin() const{
+            return a;
+        }
+
+        constexpr const T* end() const{
+            return a+N;
+        }
+
+        constexpr void fill(const T& value){
+            // 定长循环，运行期由编译器生成向量存储
+            for(unsigned int i=0;i<N;i++){
+                a[i]=value;
+            }
+        }
+
+        // 从 src 拷贝前 n 个元素（n<=N）
+        constexpr void copy(const T* src, unsigned int n = N){
+            d2ds_assert(n<=N);
+            if constexpr (std::is_trivially_copyable<T>::value){
+                if(!D2DS_IS_CONSTANT_EVALUATED()){
+                    if(n!=0) std::memcpy(a,src,sizeof(T)*n);
+                    return;
+                }
+            }
+            for(unsigned int i=0;i<n;i++){
+                a[i]=src[i];
             }
         }
 
-        Array& operator =(const Array& other){
-            if(this==&other)  return *this;
-            for(int i=0;i<N;i++){
-                a[i]=other.a[i];
+        constexpr Array& operator+=(const Array& other){
+            if constexpr (detail::array_use_simd<T, N>){
+                if(!D2DS_IS_CONSTANT_EVALUATED()){
+                    simd::add(a,other.a,a,N);
+                    return *this;
+                }
+            }
+            for(unsigned int i=0;i<N;i++){
+                a[i]+=other.a[i];
             }
             return *this;
         }
 
-        Array(Array && other){
-            for(int i=0;i<N;i++){
-                a[i]=std::move(other.a[i]);
+        constexpr Array& operator-=(const Array& other){
+            if constexpr (detail::array_use_simd<T, N>){
+                if(!D2DS_IS_CONSTANT_EVALUATED()){
+                    simd::sub(a,other.a,a,N);
+                    return *this;
+                }
+            }
+            for(unsigned int i=0;i<N;i++){
+                a[i]-=other.a[i];
             }
+            return *this;
         }
 
-        Array &operator=(Array && other){
-            if(this==&other)  return *this;
-            for(int i=0;i<N;i++){
-                a[i]=std::move(other.a[i]);
+        // 逐元素相乘
+        constexpr Array& operator*=(const Array& other){
+            if constexpr (detail::array_use_simd<T, N>){
+                if(!D2DS_IS_CONSTANT_EVALUATED()){
+                    simd::mul(a,other.a,a,N);
+                    return *this;
+                }
+            }
+            for(unsigned int i=0;i<N;i++){
+                a[i]*=other.a[i];
             }
             return *this;
         }
 
-        T & operator[](int index){
-            if(index<0)
-                index=index+N;
-            d2ds_assert(index>=0 && index<N);
-            return a[index];
+    private:
+        alignas(Alignment) T a[N == 0?1:N];
+    };
+
+    // 按缓存行对齐的定长数组
+    template<typename T, unsigned int N>
+    using AlignedArray = Array<T, N, CACHE_LINE_SIZE>;
+
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr Array<T, N, A> operator+(const Array<T, N, A>& x, const Array<T, N, A>& y){
+        Array<T, N, A> r=x;
+        r+=y;
+        return r;
+    }
+
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr Array<T, N, A> operator-(const Array<T, N, A>& x, const Array<T, N, A>& y){
+        Array<T, N, A> r=x;
+        r-=y;
+        return r;
+    }
+
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr Array<T, N, A> operator*(const Array<T, N, A>& x, const Array<T, N, A>& y){
+        Array<T, N, A> r=x;
+        r*=y;
+        return r;
+    }
+
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr bool operator==(const Array<T, N, A>& x, const Array<T, N, A>& y){
+        if constexpr (simd::is_vectorizable<T>::value){
+            if(!D2DS_IS_CONSTANT_EVALUATED())
+                return simd::equal(x.data(),y.data(),N);
         }
+        for(unsigned int i=0;i<N;i++){
+            if(!(x.data()[i]==y.data()[i]))
+                return false;
+        }
+        return true;
+    }
 
-        unsigned int size() const{
-            return N;
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr bool operator!=(const Array<T, N, A>& x, const Array<T, N, A>& y){
+        return !(x==y);
+    }
+
+    // 字典序比较
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr bool operator<(const Array<T, N, A>& x, const Array<T, N, A>& y){
+        for(unsigned int i=0;i<N;i++){
+            if(x.data()[i]<y.data()[i]) return true;
+            if(y.data()[i]<x.data()[i]) return false;
         }
+        return false;
+    }
 
-        const T& back() const{
-            return a[N==0?0:N-1];
+    // ---- 归约：与 Vector 的 sum / dot 对应；浮点在 SIMD 路径下是分组累加 ----
+
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr T sum(const Array<T, N, A>& x){
+        if constexpr (detail::array_use_simd<T, N>){
+            if(!D2DS_IS_CONSTANT_EVALUATED())
+                return simd::sum(x.data(),N);
         }
+        T r=T();
+        for(unsigned int i=0;i<N;i++)
+            r=r+x.data()[i];
+        return r;
+    }
 
-        T* begin(){
-            return a;
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr T dot(const Array<T, N, A>& x, const Array<T, N, A>& y){
+        if constexpr (detail::array_use_simd<T, N>){
+            if(!D2DS_IS_CONSTANT_EVALUATED())
+                return simd::dot(x.data(),y.data(),N);
         }
+        T r=T();
+        for(unsigned int i=0;i<N;i++)
+            r=r+x.data()[i]*y.data()[i];
+        return r;
+    }
 
-        T* end(){
-            return a+N;
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr T min(const Array<T, N, A>& x){
+        static_assert(N>0, "min of an empty d2ds::Array");
+        if constexpr (detail::array_use_simd<T, N>){
+            if(!D2DS_IS_CONSTANT_EVALUATED())
+                return simd::min(x.data(),N);
         }
-    
-    private:
-        T a[N == 0?1:N];
-    };
+        T r=x.data()[0];
+        for(unsigned int i=1;i<N;i++)
+            if(x.data()[i]<r) r=x.data()[i];
+        return r;
+    }
+
+    template<typename T, unsigned int N, unsigned int A>
+    constexpr T max(const Array<T, N, A>& x){
+        static_assert(N>0, "max of an empty d2ds::Array");
+        if constexpr (detail::array_use_simd<T, N>){
+            if(!D2DS_IS_CONSTANT_EVALUATED())
+                return simd::max(x.data(),N);
+        }
+        T r=x.data()[0];
+        for(unsigned int i=1;i<N;i++)
+            if(r<x.data()[i]) r=x.data()[i];
+        return r;
+    }
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,150 @@
+#ifndef FLAT_MAP_HPP_D2DS
+#define FLAT_MAP_HPP_D2DS
+
+#include <algorithm>
+#include <functional>
+
+#include "common/common.hpp"
+#include "array/Vector.hpp"
+
+namespace d2ds {
+// show your code
+
+// 有序扁平 map：元素是按键排好序的 Vector<pair<K, V>>，查找是二分，遍历和区间扫描是顺序读连续内存。
+// 适合“建一次、查很多次”的字典：
+//   - 单个 insert / erase 要挪动后面的元素，O(n)；
+//   - 批量插入 insert_batch 先把新元素追加到末尾排序，再与原有部分做一次归并，O(n + m log m)。
+// 元素存放的是 pair<K, V>（键可移动，便于挪动），不要通过迭代器修改键。
+template<typename K, typename V, typename Compare = std::less<K>, typename Allocator = DefaultAllocator>
+class FlatMap {
+public:
+    using value_type = std::pair<K, V>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    FlatMap() = default;
+
+    // 元素可以无序、可以重复（重复的键保留第一次出现的）
+    FlatMap(std::initializer_list<value_type> list) {
+        insert_batch(list.begin(), list.end());
+    }
+
+    unsigned int size() const { return _data.size(); }
+    bool empty() const { return _data.size() == 0; }
+    void reserve(unsigned int n) { _data.reserve(n); }
+
+    iterator begin() { return _data.begin(); }
+    iterator end() { return _data.end(); }
+    const_iterator begin() const { return _data.begin(); }
+    const_iterator end() const { return _data.end(); }
+
+    iterator lower_bound(const K& key) {
+        return std::lower_bound(begin(), end(), key,
+                                [this](const value_type& kv, const K& k) { return _less(kv.first, k); });
+    }
+
+    iterator upper_bound(const K& key) {
+        return std::upper_bound(begin(), end(), key,
+                                [this](const K& k, const value_type& kv) { return _less(k, kv.first); });
+    }
+
+    const_iterator lower_bound(const K& key) const { return const_cast<FlatMap*>(this)->lower_bound(key); }
+    const_iterator upper_bound(const K& key) const { return const_cast<FlatMap*>(this)->upper_bound(key); }
+
+    iterator find(const K& key) {
+        iterator it = lower_bound(key);
+        return it != end() && !_less(key, it->first) ? it : end();
+    }
+
+    const_iterator find(const K& key) const { return const_cast<FlatMap*>(this)->find(key); }
+
+    bool contains(const K& key) const { return find(key) != end(); }
+
+    V& at(const K& key) {
+        iterator it = find(key);
+        d2ds_assert(it != end());
+        return it->second;
+    }
+
+    const V& at(const K& key) const { return const_cast<FlatMap*>(this)->at(key); }
+
+    V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+    // 键已存在时不修改，返回 (该元素, false)
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        iterator it = lower_bound(key);
+        if (it != end() && !_less(key, it->first))
+            return {it, false};
+        unsigned int pos = unsigned(it - begin());
+        // 追加到末尾再旋转到目标位置；追加可能扩容，所以用下标而不是指针
+        _data.emplace_back(std::piecewise_construct, std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+        std::rotate(begin() + pos, end() - 1, end());
+        return {begin() + pos, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& kv) { return try_emplace(kv.first, kv.second); }
+
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+        auto res = try_emplace(key, std::forward<M>(value));
+        if (!res.second)
+            res.first->second = std::forward<M>(value);
+        return res;
+    }
+
+    // 批量插入 [first, last)：已存在的键不覆盖，批内重复的键保留第一次出现的。
+    // 新元素追加到末尾 -> 稳定排序 -> 与原有部分原地归并 -> 去重，只做一次整体搬移
+    template<typename InputIt>
+    void insert_batch(InputIt first, InputIt last) {
+        unsigned int old_size = size();
+        for (; first != last; ++first)
+            _data.push_back(*first);
+        if (size() == old_size) return;
+        auto key_less = [this](const value_type& a, const value_type& b) { return _less(a.first, b.first); };
+        iterator mid = begin() + old_size;
+        std::stable_sort(mid, end(), key_less);
+        std::inplace_merge(begin(), mid, end(), key_less); // 稳定：键相等时原有元素在前
+        iterator tail = std::unique(begin(), end(), [this](const value_type& a, const value_type& b) {
+            return !_less(a.first, b.first) && !_less(b.first, a.first);
+        });
+        unsigned int kept = unsigned(tail - begin());
+        while (size() > kept)
+            _data.pop_back();
+    }
+
+    iterator erase(iterator pos) {
+        unsigned int index = unsigned(pos - begin());
+        std::move(pos + 1, end(), pos);
+        _data.pop_back();
+        return begin() + index;
+    }
+
+    unsigned int erase(const K& key) {
+        iterator it = find(key);
+        if (it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+
+    void clear() {
+        while (size() > 0)
+            _data.pop_back();
+    }
+
+    // 按键升序对 [lo, hi) 内的元素调用 f(key, value)
+    template<typename F>
+    void scan(const K& lo, const K& hi, F f) const {
+        for (const_iterator it = lower_bound(lo); it != end() && _less(it->first, hi); ++it)
+            f(it->first, it->second);
+    }
+
+private:
+    Vector<value_type, Allocator> _data;
+    Compare _less;
+};
+
+} // namespace d2ds
+
+#endif
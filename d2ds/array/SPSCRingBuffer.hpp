@@ -0,0 +1,171 @@
+#ifndef SPSC_RING_BUFFER_HPP_D2DS
+#define SPSC_RING_BUFFER_HPP_D2DS
+
+#include <atomic>
+#include <optional>
+#include <type_traits>
+
+#include "common/common.hpp"
+#include "array/Array.hpp"
+
+namespace d2ds {
+// show your code
+
+    // 有界无锁环形队列（单生产者单消费者），槽位是一个按缓存行对齐的 d2ds::Array：
+    //   - head / tail 是只增不减的计数，槽位下标为 计数 & (Capacity - 1)，Capacity 必须是 2 的幂，全部槽位都可用；
+    //   - 只有生产者写 tail、只有消费者写 head，不需要 CAS：写完槽位后 release 存储计数，对方 acquire 读到计数就能看到数据；
+    //   - head 与 tail 各占一条缓存行，每一侧还在自己的缓存行里缓存对方的计数，
+    //     只有缓存值显示“满”（生产者）或“空”（消费者）时才去读对方的那条行，平时两个线程互不打扰；
+    //   - push_n / pop_n 一次搬运一批，每批只发布一次计数，元素可平凡复制时按段 memcpy。
+    // 槽位在构造时全部默认构造，push 是赋值、pop 是移出，被移出的对象留在槽位中直到被覆盖或队列析构。
+    // 只允许一个线程调用 push 系列、另一个线程调用 pop 系列；size / empty 只是某一时刻的近似值。
+    template<typename T, unsigned int Capacity>
+    class SPSCRingBuffer{
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "ring buffer capacity must be a power of two");
+        static_assert(std::is_default_constructible<T>::value, "ring buffer slots are default-constructed");
+
+    public:
+        SPSCRingBuffer()=default;
+        SPSCRingBuffer(const SPSCRingBuffer&)=delete;
+        SPSCRingBuffer& operator=(const SPSCRingBuffer&)=delete;
+
+        static constexpr unsigned int capacity(){
+            return Capacity;
+        }
+
+        // ---- 生产者 ----
+
+        // 队列满时返回 false
+        bool try_push(const T& value){
+            return push_with(value);
+        }
+
+        bool try_push(T&& value){
+            return push_with(std::move(value));
+        }
+
+        // 先构造临时对象再移动赋值到槽位
+        template<typename... Args>
+        bool try_emplace(Args&&... args){
+            return push_with(T(std::forward<Args>(args)...));
+        }
+
+        // 最多压入 src[0, n) 中能放下的前若干个，返回实际压入的个数
+        size_t push_n(const T* src, size_t n){
+            size_t tail=_tail.load(std::memory_order_relaxed);
+            size_t free=Capacity-(tail-_head_cache);
+            if(free<n){
+                _head_cache=_head.load(std::memory_order_acquire);
+                free=Capacity-(tail-_head_cache);
+            }
+            if(n>free) n=free;
+            if(n==0) return 0;
+            size_t pos=tail&kMask;
+            size_t first=n<Capacity-pos ? n : Capacity-pos; // 到数组末尾的一段，剩下的从头开始
+            copy_n(src,_slots.data()+pos,first);
+            copy_n(src+first,_slots.data(),n-first);
+            _tail.store(tail+n,std::memory_order_release);
+            return n;
+        }
+
+        // ---- 消费者 ----
+
+        // 队列为空时返回 false
+        bool try_pop(T& out){
+            size_t head=_head.load(std::memory_order_relaxed);
+            if(head==_tail_cache){
+                _tail_cache=_tail.load(std::memory_order_acquire);
+                if(head==_tail_cache)
+                    return false;
+            }
+            out=std::move(_slots.data()[head&kMask]);
+            _head.store(head+1,std::memory_order_release);
+            return true;
+        }
+
+        std::optional<T> try_pop(){
+            std::optional<T> result;
+            size_t head=_head.load(std::memory_order_relaxed);
+            if(head==_tail_cache){
+                _tail_cache=_tail.load(std::memory_order_acquire);
+                if(head==_tail_cache)
+                    return result;
+            }
+            result.emplace(std::move(_slots.data()[head&kMask]));
+            _head.store(head+1,std::memory_order_release);
+            return result;
+        }
+
+        // 最多弹出 n 个到 dst，返回实际弹出的个数
+        size_t pop_n(T* dst, size_t n){
+            size_t head=_head.load(std::memory_order_relaxed);
+            size_t avail=_tail_cache-head;
+            if(avail<n){
+                _tail_cache=_tail.load(std::memory_order_acquire);
+                avail=_tail_cache-head;
+            }
+            if(n>avail) n=avail;
+            if(n==0) return 0;
+            size_t pos=head&kMask;
+            size_t first=n<Capacity-pos ? n : Capacity-pos;
+            move_n(_slots.data()+pos,dst,first);
+            move_n(_slots.data(),dst+first,n-first);
+            _head.store(head+n,std::memory_order_release);
+            return n;
+        }
+
+        // ---- 任意线程 ----
+
+        size_t size() const{
+            size_t head=_head.load(std::memory_order_acquire);
+            size_t tail=_tail.load(std::memory_order_acquire);
+            return tail>=head ? tail-head : 0;
+        }
+
+        bool empty() const{
+            return size()==0;
+        }
+
+    private:
+        static constexpr size_t kMask = Capacity - 1;
+
+        template<typename U>
+        bool push_with(U&& value){
+            size_t tail=_tail.load(std::memory_order_relaxed);
+            if(tail-_head_cache==Capacity){
+                _head_cache=_head.load(std::memory_order_acquire);
+                if(tail-_head_cache==Capacity)
+                    return false;
+            }
+            _slots.data()[tail&kMask]=std::forward<U>(value);
+            _tail.store(tail+1,std::memory_order_release);
+            return true;
+        }
+
+        static void copy_n(const T* src, T* dst, size_t n){
+            if constexpr (std::is_trivially_copyable<T>::value){
+                if(n!=0) std::memcpy(dst,src,sizeof(T)*n);
+            }else{
+                for(size_t i=0;i<n;i++) dst[i]=src[i];
+            }
+        }
+
+        static void move_n(T* src, T* dst, size_t n){
+            if constexpr (std::is_trivially_copyable<T>::value){
+                if(n!=0) std::memcpy(dst,src,sizeof(T)*n);
+            }else{
+                for(size_t i=0;i<n;i++) dst[i]=std::move(src[i]);
+            }
+        }
+
+        // 生产者的缓存行：tail 由生产者写、消费者读；_head_cache 只有生产者访问
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};
+        size_t _head_cache=0;
+        // 消费者的缓存行
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head{0};
+        size_t _tail_cache=0;
+        Array<T, Capacity, CACHE_LINE_SIZE> _slots;
+    };
+}
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef SMALL_VECTOR_HPP_D2DS
+#define SMALL_VECTOR_HPP_D2DS
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "common/common.hpp"
+
+namespace d2ds {
+// show your code
+
+// 带内联存储的 Vector：不超过 N 个元素时直接放在对象内部的缓冲区里，不走分配器；
+// 超过 N 个才“溢出”到 Allocator 分配的堆缓冲区，之后的行为与 Vector 相同。
+// 接口与 Vector 保持一致（resize 同样表示调整容量）。
+// 注意：内联状态下的 move 需要逐个搬迁元素，代价是 O(n) 而不是交换指针。
+template<typename T, unsigned int N, typename Allocator = DefaultAllocator>
+class SmallVector{
+    static_assert(N > 0, "SmallVector needs at least one inline slot");
+public:
+    SmallVector(): _size(0),_capacity(N),_data(inline_data()){}
+
+    SmallVector(unsigned int n): SmallVector(){
+        reserve(n);
+        for(unsigned int i=0;i<n;i++)
+            new (_data+i) T();
+        _size=n;
+    }
+
+    SmallVector(std::initializer_list<T> list): SmallVector(){
+        reserve(list.size());
+        for(auto it=list.begin();it!=list.end();it++)
+            new (_data+_size++) T(*it);
+    }
+
+    SmallVector(const SmallVector& other): SmallVector(){
+        reserve(other._size);
+        for(unsigned int i=0;i<other._size;i++)
+            new (_data+i) T(other._data[i]);
+        _size=other._size;
+    }
+
+    SmallVector& operator=(const SmallVector& dsObj){
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        clear();
+        reserve(dsObj._size);
+        for(unsigned int i=0;i<dsObj._size;i++)
+            new (_data+i) T(dsObj._data[i]);
+        _size=dsObj._size;
+        return *this;
+    }
+
+    SmallVector(SmallVector&& other): SmallVector(){
+        take(std::move(other));
+    }
+
+    SmallVector& operator=(SmallVector&& dsObj){
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        clear();
+        release_heap();
+        take(std::move(dsObj));
+        return *this;
+    }
+
+    ~SmallVector(){
+        clear();
+        release_heap();
+    }
+
+    unsigned int size() const{
+        return _size;
+    }
+
+    bool empty() const{
+        return _size==0;
+    }
+
+    unsigned int capacity() const{
+        return _capacity;
+    }
+
+    // 当前元素是否存放在内联缓冲区中
+    bool is_inline() const{
+        return _data==inline_data();
+    }
+
+    T& operator[](unsigned int i){
+        return _data[i];
+    }
+
+    const T& operator[](unsigned int i) const{
+        return _data[i];
+    }
+
+    void push_back(const T& a){
+        emplace_back(a);
+    }
+
+    void push_back(T&& a){
+        emplace_back(std::move(a));
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args){
+        if(_size+1>_capacity){
+            // 参数可能引用本容器内的元素，扩容会把它搬走，所以先构造到临时对象里
+            T tmp(std::forward<Args>(args)...);
+            resize(2*_capacity);
+            new(_data+_size) T(std::move(tmp));
+        }else{
+            new(_data+_size) T(std::forward<Args>(args)...);
+        }
+        _size+=1;
+        return _data[_size-1];
+    }
+
+    // 不做自动收缩：小容器的容量本来就小，需要归还内存时用 shrink_to_fit
+    void pop_back(){
+        _size-=1;
+        (_data+_size)->~T();
+    }
+
+    void clear(){
+        for(unsigned int i=0;i<_size;i++)
+            (_data+i)->~T();
+        _size=0;
+    }
+
+    void reserve(unsigned int n){
+        if(n>_capacity)
+            resize(n);
+    }
+
+    // 元素数不超过 N 时搬回内联缓冲区并释放堆内存
+    void shrink_to_fit(){
+        if(!is_inline() && _capacity>_size)
+            resize(_size);
+    }
+
+    void resize_default_init(unsigned int n){
+        reserve(n);
+        for(unsigned int i=_size;i<n;i++)
+            new(_data+i) T;
+        for(unsigned int i=n;i<_size;i++)
+            (_data+i)->~T();
+        _size=n;
+    }
+
+    // 调整容量为 n（要求 _size<=n）；n<=N 时回到内联缓冲区
+    void resize(unsigned int n){
+        if(n<=N){
+            if(is_inline()) return;
+            T* heap=_data;
+            unsigned int heap_capacity=_capacity;
+            relocate(heap,_size,inline_data());
+            Allocator::deallocate(heap,sizeof(T)*heap_capacity);
+            _data=inline_data();
+            _capacity=N;
+            return;
+        }
+        if(n==_capacity) return;
+
+        T* new_mem=static_cast<T*>(Allocator::allocate(sizeof(T)*n));
+        try{
+            relocate(_data,_size,new_mem);
+        }catch(...){
+            Allocator::deallocate(new_mem,sizeof(T)*n);
+            throw;
+        }
+        release_heap();
+        _data=new_mem;
+        _capacity=n;
+    }
+
+    T* begin(){
+        return _data;
+    }
+
+    T* end(){
+        return _data+_size;
+    }
+
+    const T* begin() const{
+        return _data;
+    }
+
+    const T* end() const{
+        return _data+_size;
+    }
+
+    template<typename U, unsigned int M, typename A>
+    friend bool operator==(const SmallVector<U, M, A>& v1, const SmallVector<U, M, A>& v2);
+
+private:
+    T* inline_data(){
+        return reinterpret_cast<T*>(_inline);
+    }
+
+    const T* inline_data() const{
+        return reinterpret_cast<const T*>(_inline);
+    }
+
+    // 仅释放堆缓冲区本身（元素需已析构或已搬走），之后回到空的内联状态
+    void release_heap(){
+        if(!is_inline())
+            Allocator::deallocate(_data,sizeof(T)*_capacity);
+        _data=inline_data();
+        _capacity=N;
+    }
+
+    // 要求 *this 为空且处于内联状态
+    void take(SmallVector&& other){
+        if(other.is_inline()){
+            relocate(other._data,other._size,_data);
+        }else{
+            _data=other._data;
+            _capacity=other._capacity;
+            other._data=other.inline_data();
+            other._capacity=N;
+        }
+        _size=other._size;
+        other._size=0;
+    }
+
+    unsigned int _size,_capacity;
+    T* _data;
+    alignas(T) unsigned char _inline[sizeof(T)*N];
+};
+
+template<typename T, unsigned int N, typename Allocator>
+bool operator==(const SmallVector<T, N, Allocator>& v1, const SmallVector<T, N, Allocator>& v2){
+    if(v1._size!=v2._size) return false;
+    for(unsigned int i=0;i<v1._size;i++){
+        if(v1._data[i]!=v2._data[i])
+            return false;
+    }
+    return true;
+}
+
+} // namespace d2ds
+
+#endif
@@ -0,0 +1,275 @@
+#ifndef STATIC_SEARCH_HPP_D2DS
+#define STATIC_SEARCH_HPP_D2DS
+
+#include <functional>
+#include <limits>
+
+#include "common/common.hpp"
+#include "common/simd.hpp"
+#include "array/Vector.hpp"
+
+namespace d2ds {
+// show your code
+
+// 静态有序查找：把排好序、之后不再修改的数组重新排布，让 lower_bound 的每次探测尽量命中缓存。
+// 普通二分的前几次探测落在相距很远的位置，数组一大，几乎每一步都是一次缓存未命中，而且下一步地址依赖本次比较，
+// CPU 只能干等。下面两种布局都返回原有序数组中的下标，可以直接拿去索引并行存放的值数组。
+
+// Eytzinger (BFS) 布局：按完全二叉树的层序存放，b[1] 是根，b[k] 的孩子是 b[2k] 和 b[2k+1]。
+//   - 前几层挤在开头的几条缓存行里，总是热的；
+//   - 查找是固定次数的 k = 2k + (b[k] < x)，没有分支；
+//   - b[k] 往下 log2(每行元素数) 层的所有后代恰好连续占一条缓存行，每步顺手预取它，访存与比较流水起来；
+//   - lower_bound_batch 交错推进多个查询，多个未命中同时在路上。
+template<typename T, typename Compare = std::less<T>, typename Allocator = DefaultAllocator>
+class EytzingerArray {
+public:
+    static constexpr unsigned int npos = std::numeric_limits<unsigned int>::max();
+    // 批量查询时同时推进的查询数
+    static constexpr size_t kBatch = 8;
+
+    EytzingerArray() = default;
+
+    template<typename A>
+    explicit EytzingerArray(const Vector<T, A>& sorted) : EytzingerArray(sorted.begin(), sorted.size()) {}
+
+    // sorted 需已按 Compare 升序排列
+    EytzingerArray(const T* sorted, unsigned int n) : _n(n) {
+        if (n == 0) return;
+        _b = static_cast<T*>(aligned_allocate<Allocator>(sizeof(T) * (size_t(n) + 1), CACHE_LINE_SIZE));
+        _rank = static_cast<unsigned int*>(Allocator::allocate(sizeof(unsigned int) * (size_t(n) + 1)));
+        unsigned int i = 0;
+        fill(sorted, i, 1);
+        while ((size_t(2) << _full_levels) - 1 <= n) _full_levels++;
+    }
+
+    EytzingerArray(const EytzingerArray&) = delete;
+    EytzingerArray& operator=(const EytzingerArray&) = delete;
+
+    EytzingerArray(EytzingerArray&& other) { take(other); }
+
+    EytzingerArray& operator=(EytzingerArray&& dsObj) {
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        destroy();
+        take(dsObj);
+        return *this;
+    }
+
+    ~EytzingerArray() { destroy(); }
+
+    unsigned int size() const { return _n; }
+
+    // 原有序数组中第一个不小于 x 的下标，没有则返回 size()
+    unsigned int lower_bound(const T& x) const {
+        size_t k = descend(x);
+        return k == 0 ? _n : _rank[k];
+    }
+
+    // x 所在的有序下标（有重复时是第一个），不存在返回 npos
+    unsigned int find(const T& x) const {
+        size_t k = descend(x);
+        return k == 0 || _less(x, _b[k]) ? npos : _rank[k];
+    }
+
+    bool contains(const T& x) const { return find(x) != npos; }
+
+    // out[j] = lower_bound(xs[j])：每 kBatch 个查询一组，逐层同时推进，组内各查询的未命中可以重叠
+    void lower_bound_batch(const T* xs, unsigned int* out, size_t m) const {
+        for (size_t base = 0; base < m; base += kBatch) {
+            size_t g = m - base < kBatch ? m - base : kBatch;
+            size_t k[kBatch];
+            for (size_t j = 0; j < g; ++j) k[j] = 1;
+            for (unsigned int l = 0; l < _full_levels; ++l) {
+                for (size_t j = 0; j < g; ++j) {
+                    __builtin_prefetch(_b + k[j] * kPrefetchStride);
+                    k[j] = 2 * k[j] + size_t(_less(_b[k[j]], xs[base + j]));
+                }
+            }
+            for (size_t j = 0; j < g; ++j) {
+                if (k[j] <= _n) k[j] = 2 * k[j] + size_t(_less(_b[k[j]], xs[base + j]));
+                k[j] = resolve(k[j]);
+                out[base + j] = k[j] == 0 ? _n : _rank[k[j]];
+            }
+        }
+    }
+
+private:
+    // b[k] 往下 log2(kPrefetchStride) 层的后代是 b[k * kPrefetchStride ...]，连续一条缓存行
+    static constexpr size_t kPrefetchStride = CACHE_LINE_SIZE / sizeof(T) > 0 ? CACHE_LINE_SIZE / sizeof(T) : 1;
+
+    // 中序遍历就是原有序顺序
+    void fill(const T* sorted, unsigned int& i, size_t k) {
+        if (k > _n) return;
+        fill(sorted, i, 2 * k);
+        new (_b + k) T(sorted[i]);
+        _rank[k] = i++;
+        fill(sorted, i, 2 * k + 1);
+    }
+
+    // 返回第一个不小于 x 的元素在 _b 中的位置，没有则返回 0
+    size_t descend(const T& x) const {
+        size_t k = 1;
+        for (unsigned int l = 0; l < _full_levels; ++l) {
+            __builtin_prefetch(_b + k * kPrefetchStride);
+            k = 2 * k + size_t(_less(_b[k], x));
+        }
+        if (k <= _n) k = 2 * k + size_t(_less(_b[k], x)); // 最后一层不满
+        return resolve(k);
+    }
+
+    // 下降路径的二进制末尾是“最后一次向左之后的连续向右”，去掉这些右转和最后那次左转就回到答案节点；
+    // 全程向右（所有元素都 < x）时得到 0
+    static size_t resolve(size_t k) {
+        return k >> __builtin_ffsll(static_cast<long long>(~k));
+    }
+
+    void destroy() {
+        if (_b == nullptr) return;
+        for (size_t k = 1; k <= _n; ++k) _b[k].~T();
+        aligned_deallocate<Allocator>(_b, sizeof(T) * (size_t(_n) + 1), CACHE_LINE_SIZE);
+        Allocator::deallocate(_rank, sizeof(unsigned int) * (size_t(_n) + 1));
+        _b = nullptr;
+        _rank = nullptr;
+        _n = 0;
+        _full_levels = 0;
+    }
+
+    void take(EytzingerArray& other) {
+        _b = other._b;
+        _rank = other._rank;
+        _n = other._n;
+        _full_levels = other._full_levels;
+        other._b = nullptr;
+        other._rank = nullptr;
+        other._n = 0;
+        other._full_levels = 0;
+    }
+
+    T* _b = nullptr;                // _b[1.._n]，_b[0] 不用；_b 按缓存行对齐
+    unsigned int* _rank = nullptr;  // _rank[k] 是 _b[k] 在原有序数组中的下标
+    unsigned int _n = 0;
+    unsigned int _full_levels = 0;  // 完全填满的层数：这些层的探测不需要越界检查
+    Compare _less;
+};
+
+// 静态 B 树（S-tree）：每个块是一条缓存行的有序键，块 k 的 B+1 个孩子是块 k*(B+1)+1 ... k*(B+1)+B+1，
+// 不存指针。每层只访问一条缓存行，块内用 simd::rank 一次比较整行，树高 log_{B+1}(n)，
+// 比 Eytzinger 少得多的访存次数，代价是块内比较更多。只支持算术类型（空位用 simd::rank_padding 填充，键不能是 NaN）。
+template<typename T, typename Allocator = DefaultAllocator>
+class StaticBTree {
+    static_assert(simd::has_rank<T>::value, "StaticBTree needs an arithmetic key type");
+
+public:
+    static constexpr unsigned int npos = std::numeric_limits<unsigned int>::max();
+    static constexpr size_t B = CACHE_LINE_SIZE / sizeof(T);
+
+    StaticBTree() = default;
+
+    template<typename A>
+    explicit StaticBTree(const Vector<T, A>& sorted) : StaticBTree(sorted.begin(), sorted.size()) {}
+
+    StaticBTree(const T* sorted, unsigned int n) : _n(n) {
+        _blocks = (size_t(n) + B - 1) / B;
+        if (_blocks == 0) return;
+        _tree = static_cast<Block*>(aligned_allocate<Allocator>(sizeof(Block) * _blocks, CACHE_LINE_SIZE));
+        _rank = static_cast<unsigned int*>(Allocator::allocate(sizeof(unsigned int) * _blocks * B));
+        unsigned int t = 0;
+        fill(sorted, t, 0);
+    }
+
+    StaticBTree(const StaticBTree&) = delete;
+    StaticBTree& operator=(const StaticBTree&) = delete;
+
+    StaticBTree(StaticBTree&& other) { take(other); }
+
+    StaticBTree& operator=(StaticBTree&& dsObj) {
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        destroy();
+        take(dsObj);
+        return *this;
+    }
+
+    ~StaticBTree() { destroy(); }
+
+    unsigned int size() const { return _n; }
+
+    // 原有序数组中第一个不小于 x 的下标，没有则返回 size()
+    unsigned int lower_bound(T x) const {
+        size_t slot = descend(x);
+        return slot == kNone ? _n : _rank[slot];
+    }
+
+    // x 所在的有序下标（有重复时是第一个），不存在返回 npos
+    unsigned int find(T x) const {
+        size_t slot = descend(x);
+        if (slot == kNone || _rank[slot] == _n || _tree[slot / B].keys[slot % B] != x) return npos;
+        return _rank[slot];
+    }
+
+    bool contains(T x) const { return find(x) != npos; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Block {
+        T keys[B];
+    };
+
+    static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+    // 返回第一个不小于 x 的槽位 k*B+i，没有则返回 kNone。
+    // 落在空位上说明右边已没有真实元素，_rank 中空位记的就是 _n
+    size_t descend(T x) const {
+        size_t slot = kNone;
+        size_t k = 0;
+        while (k < _blocks) {
+            unsigned int i = simd::rank<false>(_tree[k].keys, x);
+            if (i < B) slot = k * B + i;
+            k = k * (B + 1) + i + 1;
+        }
+        return slot;
+    }
+
+    // 按中序把有序元素填进块，最后一个元素之后的空位填 rank_padding、下标记为 _n
+    void fill(const T* sorted, unsigned int& t, size_t k) {
+        if (k >= _blocks) return;
+        for (size_t i = 0; i < B; ++i) {
+            fill(sorted, t, k * (B + 1) + i + 1);
+            if (t < _n) {
+                _tree[k].keys[i] = sorted[t];
+                _rank[k * B + i] = t++;
+            } else {
+                _tree[k].keys[i] = simd::rank_padding<T>();
+                _rank[k * B + i] = _n;
+            }
+        }
+        fill(sorted, t, k * (B + 1) + B + 1);
+    }
+
+    void destroy() {
+        if (_tree == nullptr) return;
+        aligned_deallocate<Allocator>(_tree, sizeof(Block) * _blocks, CACHE_LINE_SIZE);
+        Allocator::deallocate(_rank, sizeof(unsigned int) * _blocks * B);
+        _tree = nullptr;
+        _rank = nullptr;
+        _n = 0;
+        _blocks = 0;
+    }
+
+    void take(StaticBTree& other) {
+        _tree = other._tree;
+        _rank = other._rank;
+        _n = other._n;
+        _blocks = other._blocks;
+        other._tree = nullptr;
+        other._rank = nullptr;
+        other._n = 0;
+        other._blocks = 0;
+    }
+
+    Block* _tree = nullptr;
+    unsigned int* _rank = nullptr;
+    unsigned int _n = 0;
+    size_t _blocks = 0;
+};
+
+} // namespace d2ds
+
+#endif
@@ -2,8 +2,11 @@
 #define VECTOR_HPP_D2DS
 
 #include <initializer_list>
+#include <type_traits>
 
 #include "common/common.hpp"
+#include "common/simd.hpp"
+#include "array/VectorExpr.hpp"
 
 namespace d2ds {
 // show your code
@@ -25,6 +28,18 @@ public:
             new (_data+(it - list.begin())) T(*it);
         }
     }
+    // 从表达式 (a + b - c ...) 构造：一次融合求值，不产生中间 Vector
+    template<typename E>
+    Vector(const VecExpr<E>& expr): Vector(){
+        assign_expr(expr.self());
+    }
+
+    template<typename E>
+    Vector& operator=(const VecExpr<E>& expr){
+        assign_expr(expr.self());
+        return *this;
+    }
+
     ~Vector(){
         for(int i=0;i<_size;i++){
             (_data+i)->~T();
@@ -93,26 +108,76 @@ public:
     }
 
     void push_back(const T& a){
+        emplace_back(a);
+    }
+
+    void push_back(T&& a){
+        emplace_back(std::move(a));
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args){
         if(_size+1>_capacity){
+            // 参数可能引用本容器内的元素，扩容会把它搬走，所以先构造到临时对象里
+            T tmp(std::forward<Args>(args)...);
             resize(_capacity==0?2:2*_capacity);
+            new(_data+_size) T(std::move(tmp));
+        }else{
+            new(_data+_size) T(std::forward<Args>(args)...);
         }
-        new(_data+_size) T(a);
         _size+=1;
+        return _data[_size-1];
     }
 
+    // 收缩策略（带滞回）：元素降到容量的 1/4 以下才减半，减半后仍留一半空位，
+    // 需要再 push 一倍的元素才会重新扩容，push/pop 在边界附近交替时不会反复分配；
+    // 容量不会被自动收缩到 SHRINK_MIN_CAPACITY 以下，需要归还内存请用 shrink_to_fit
     void pop_back(){
         _size-=1;
         (_data+_size)->~T();
-        if(_size<=_capacity/3){
-            resize(_capacity/2);
+        if(_capacity>SHRINK_MIN_CAPACITY && _size<_capacity/4){
+            unsigned int n=_capacity/2;
+            resize(n<SHRINK_MIN_CAPACITY?SHRINK_MIN_CAPACITY:n);
         }
     }
 
+    // 预留至少 n 个元素的容量，之后 n 个以内的 push_back 不再分配
+    void reserve(unsigned int n){
+        if(n>_capacity)
+            resize(n);
+    }
+
+    void shrink_to_fit(){
+        if(_capacity>_size)
+            resize(_size);
+    }
+
+    // 把大小改为 n，新增元素只做默认初始化（int 等平凡类型不清零），
+    // 用于随后整块写入的场景（读文件、memcpy），省掉一次无意义的清零
+    void resize_default_init(unsigned int n){
+        if(n>_capacity)
+            resize(n);
+        for(unsigned int i=_size;i<n;i++)
+            new(_data+i) T;
+        for(unsigned int i=n;i<_size;i++)
+            (_data+i)->~T();
+        _size=n;
+    }
+
+    // 调整容量为 n（要求 _size<=n），元素搬迁策略：
+    //   1. 可平凡搬迁的类型且分配器支持 reallocate：交给分配器，能原地扩容则零拷贝
+    //   2. 可平凡搬迁的类型：一次 memcpy
+    //   3. 其他类型：move_if_noexcept 逐个搬迁（移动构造可能抛异常时退回拷贝，保证强异常安全）
     void resize(unsigned int n){//_size<=n
+        if(n==_capacity) return;
+        if(try_reallocate(n)) return;
+
         T* new_mem=(n==0?nullptr:static_cast<T*>(Allocator::allocate(sizeof(T)*n)));
-        for(int i=0;i<_size;i++){
-            new (new_mem+i) T(_data[i]);
-            (_data+i)->~T();
+        try{
+            relocate(_data,_size,new_mem);
+        }catch(...){
+            Allocator::deallocate(new_mem,sizeof(T)*n);
+            throw;
         }
         if(_data)
             Allocator::deallocate(_data,sizeof(T)*_capacity);
@@ -143,22 +208,60 @@ public:
 
     template<typename U>
     friend bool operator==(const Vector<U>& v1, const Vector<U>&v2);
+private:
+    static constexpr unsigned int SHRINK_MIN_CAPACITY=16;
 
-    template<typename U>
-    friend Vector<U> operator+(const Vector<U>& v1, const Vector<U>&v2);
+    template<typename E>
+    void assign_expr(const E& e){
+        unsigned int n=e.size();
+        if constexpr (simd::is_vectorizable<T>::value){
+            // 逐元素运算在同一下标上先读后写，a = a + b 这类别名可以直接原地求值
+            if(_size!=n){
+                Vector tmp;
+                tmp.resize_default_init(n);
+                simd::detail::dispatch<simd::detail::EvalExpr>(e,tmp._data,size_t(n));
+                *this=std::move(tmp);
+            }else{
+                simd::detail::dispatch<simd::detail::EvalExpr>(e,_data,size_t(n));
+            }
+        }else{
+            Vector tmp;
+            tmp.reserve(n);
+            for(unsigned int i=0;i<n;i++){
+                new(tmp._data+i) T(e[i]);
+                tmp._size++;
+            }
+            *this=std::move(tmp);
+        }
+    }
+
+    bool try_reallocate(unsigned int n){
+        if constexpr (is_trivially_relocatable<T>::value && has_reallocate<Allocator>::value){
+            if(_data==nullptr || n==0) return false;
+            void* mem=Allocator::reallocate(_data,sizeof(T)*_capacity,sizeof(T)*n);
+            if(mem==nullptr) return false; // 原缓冲区保持不变，走普通路径
+            _data=static_cast<T*>(mem);
+            _capacity=n;
+            return true;
+        }else{
+            return false;
+        }
+    }
 
-    template<typename U>
-    friend Vector<U> operator-(const Vector<U>& v1, const Vector<U>&v);
-private:
     unsigned int _size,_capacity;
     T * _data;
 };
 
+// 算术类型走 common/simd.hpp 的向量化内核，其他类型逐元素处理
+
 template<typename T> 
 bool operator==(const Vector<T>& v1, const Vector<T>&v2){
     bool equal = v1._size == v2._size;
+    if constexpr (simd::is_vectorizable<T>::value){
+        return equal && simd::equal(v1._data,v2._data,v1._size);
+    }
     if(equal){
-        for(int i=0;i<v1._size;i++){
+        for(unsigned int i=0;i<v1._size;i++){
             if(v1._data[i]!=v2._data[i]){
                 equal=false;
                 break;
@@ -167,21 +270,64 @@ bool operator==(const Vector<T>& v1, const Vector<T>&v2){
     }
     return equal;
 }
-template<typename T>
-Vector<T> operator+(const Vector<T>& v1, const Vector<T>&v2){
-    Vector<T> v(v1._size);
-    for(int i=0;i<v1._size;i++){
-        v._data[i]=v1._data[i]+v2._data[i];   
+
+// operator+ / operator- 返回表达式节点（见 VectorExpr.hpp），赋值给 Vector 时才求值
+template<typename X>
+struct is_vector_operand : std::is_base_of<VecExpr<X>, X> {};
+
+template<typename T, typename Allocator>
+struct is_vector_operand<Vector<T, Allocator>> : std::true_type {};
+
+template<typename T, typename Allocator>
+VecRef<T> as_vector_operand(const Vector<T, Allocator>& v){
+    return VecRef<T>(v.begin(),v.size());
+}
+
+template<typename E>
+const E& as_vector_operand(const VecExpr<E>& e){
+    return e.self();
+}
+
+template<typename X>
+using vector_operand_t = std::decay_t<decltype(as_vector_operand(std::declval<const X&>()))>;
+
+template<typename L, typename R,
+         typename = std::enable_if_t<is_vector_operand<L>::value && is_vector_operand<R>::value>>
+VecBinary<simd::detail::AddOp, vector_operand_t<L>, vector_operand_t<R>>
+operator+(const L& v1, const R& v2){
+    return {as_vector_operand(v1),as_vector_operand(v2)};
+}
+
+template<typename L, typename R,
+         typename = std::enable_if_t<is_vector_operand<L>::value && is_vector_operand<R>::value>>
+VecBinary<simd::detail::SubOp, vector_operand_t<L>, vector_operand_t<R>>
+operator-(const L& v1, const R& v2){
+    return {as_vector_operand(v1),as_vector_operand(v2)};
+}
+
+// 点积与求和：直接作用于 Vector 的便捷接口；与 operator+ / operator- 一样接受任意分配器
+template<typename T, typename Allocator1, typename Allocator2>
+T dot(const Vector<T, Allocator1>& v1, const Vector<T, Allocator2>& v2){
+    if constexpr (simd::is_vectorizable<T>::value){
+        return simd::dot(v1.begin(),v2.begin(),v1.size());
+    }else{
+        T r=T();
+        for(unsigned int i=0;i<v1.size();i++)
+            r=r+v1[i]*v2[i];
+        return r;
     }
-    return v;
 }
-template<typename T>
-Vector<T> operator-(const Vector<T>& v1, const Vector<T>&v2){
-    Vector<T> v(v1._size);
-    for(int i=0;i<v1._size;i++){
-        v._data[i]=v1._data[i]-v2._data[i];     
+
+template<typename T, typename Allocator>
+T sum(const Vector<T, Allocator>& v){
+    if constexpr (simd::is_vectorizable<T>::value){
+        return simd::sum(v.begin(),v.size());
+    }else{
+        T r=T();
+        for(unsigned int i=0;i<v.size();i++)
+            r=r+v[i];
+        return r;
     }
-    return v;
 }
 } // namespace d2ds
 
@@ -0,0 +1,101 @@
+#ifndef VECTOR_EXPR_HPP_D2DS
+#define VECTOR_EXPR_HPP_D2DS
+
+#include <type_traits>
+
+#include "common/common.hpp"
+#include "common/simd.hpp"
+
+namespace d2ds {
+
+// Vector 的表达式模板：a + b - c 不再逐个运算符生成临时 Vector，
+// 而是构造一棵轻量的表达式树（只保存数据指针和长度），
+// 在赋值给 Vector 时用一个融合循环一次算完，中间不分配内存、只扫一遍内存。
+// 算术类型的融合循环走 common/simd.hpp 的分派机制，同样按 SSE2/AVX2 向量化。
+//
+// 注意：表达式只引用操作数，不拥有数据；auto e = a + b; 之后 a、b 必须比 e 活得久。
+
+// 所有表达式节点的 CRTP 基类，用来在重载决议中识别“表达式”
+template<typename E>
+struct VecExpr {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// 叶子：引用一个已有数组
+template<typename T>
+struct VecRef : VecExpr<VecRef<T>> {
+    using value_type = T;
+
+    VecRef(const T* data, unsigned int size): _data(data), _size(size) {}
+
+    unsigned int size() const { return _size; }
+    T operator[](unsigned int i) const { return _data[i]; }
+
+    template<size_t B, typename V>
+    D2DS_SIMD_INLINE void load(V& v, size_t i) const {
+        simd::detail::Lanes<T, B>::load(v, _data + i);
+    }
+
+    const T* _data;
+    unsigned int _size;
+};
+
+// 二元逐元素运算节点，Op 复用 simd 内核中的 AddOp/SubOp/MulOp（对标量和向量寄存器都适用）
+template<typename Op, typename L, typename R>
+struct VecBinary : VecExpr<VecBinary<Op, L, R>> {
+    using value_type = typename L::value_type;
+    static_assert(std::is_same<value_type, typename R::value_type>::value,
+                  "d2ds::Vector expressions need operands of the same element type");
+
+    VecBinary(const L& l, const R& r): _l(l), _r(r) {
+        d2ds_assert(l.size() == r.size());
+    }
+
+    unsigned int size() const { return _l.size(); }
+
+    value_type operator[](unsigned int i) const {
+        value_type x = _l[i];
+        Op::apply(x, _r[i]);
+        return x;
+    }
+
+    template<size_t B, typename V>
+    D2DS_SIMD_INLINE void load(V& v, size_t i) const {
+        V t;
+        _l.template load<B>(v, i);
+        _r.template load<B>(t, i);
+        Op::apply(v, t);
+    }
+
+    // 子表达式按值保存：节点本身只有几个指针大小，临时节点也不会悬空
+    L _l;
+    R _r;
+};
+
+namespace simd {
+namespace detail {
+
+// 融合求值：out[i] = e[i]，每次处理一整个向量寄存器宽度的元素
+struct EvalExpr {
+    template<size_t B, typename E, typename T>
+    static D2DS_SIMD_INLINE void run(E e, T* out, size_t n) {
+        size_t i = 0;
+        if constexpr (B != 0) {
+            using L = Lanes<T, B>;
+            typename L::V v;
+            for (; i + L::N <= n; i += L::N) {
+                e.template load<B>(v, i);
+                L::store(out + i, v);
+            }
+        }
+        for (; i < n; ++i)
+            out[i] = e[i];
+    }
+};
+
+} // namespace detail
+} // namespace simd
+
+} // namespace d2ds
+
+#endif
@@ -0,0 +1,105 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "hash-map/ConcurrentHashMap.hpp"
+
+using namespace d2ds;
+
+// 读多写少的共享缓存场景：分片 ConcurrentHashMap vs 一把互斥锁保护的 std::unordered_map
+// 键空间 [0, kKeys) 预先填满一半；每个线程做 ops 次随机操作：95% 查找 / 4% insert_or_assign / 1% 删除
+// 线程数 1, 2, 4, ... 直到 max_threads（默认 32），观察查找吞吐随核数的伸缩
+// 用法: concurrent_hash_map_bench [max_threads] [ops per thread]
+
+static const int kKeys = 1 << 20;
+
+struct LockedMap
+{
+    std::mutex mutex;
+    std::unordered_map<int, long> map;
+
+    void insert_or_assign(int k, long v)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        map[k] = v;
+    }
+    bool erase(int k)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.erase(k) == 1;
+    }
+    bool contains(int k)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.count(k) == 1;
+    }
+};
+
+template<typename Map>
+double MopsPerSecond(Map& map, unsigned int threads, unsigned int ops)
+{
+    std::vector<std::thread> workers;
+    std::atomic<long> hits{0};
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t] {
+            std::mt19937 rng(t * 7919 + 1);
+            long local = 0;
+            for (unsigned int i = 0; i < ops; ++i)
+            {
+                int key = int(rng() % kKeys);
+                unsigned int dice = rng() % 100;
+                if (dice < 95)
+                    local += map.contains(key);
+                else if (dice < 99)
+                    map.insert_or_assign(key, long(i));
+                else
+                    local += map.erase(key);
+            }
+            hits += local;
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    return double(threads) * ops / seconds / 1e6;
+}
+
+template<typename Map>
+void Fill(Map& map)
+{
+    for (int k = 0; k < kKeys; k += 2)
+        map.insert_or_assign(k, long(k));
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int max_threads = argc > 1 ? unsigned(atoi(argv[1])) : 32;
+    unsigned int ops = argc > 2 ? unsigned(atoi(argv[2])) : 1000000;
+    printf("键空间 %d, 每线程 %u 次操作 (95%% 查找), 硬件线程 %u\n", kKeys, ops, std::thread::hardware_concurrency());
+
+    for (unsigned int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        auto* sharded = new ConcurrentHashMap<int, long>;
+        LockedMap locked;
+        Fill(*sharded);
+        Fill(locked);
+        double a = MopsPerSecond(*sharded, threads, ops);
+        double b = MopsPerSecond(locked, threads, ops);
+        delete sharded;
+        printf("[%2u 线程] ConcurrentHashMap %7.2f Mops/s, mutex + std::unordered_map %7.2f Mops/s (%.2fx)\n",
+               threads, a, b, a / b);
+    }
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. benchmark/ConcurrentHashMapBench.cpp ../MemoryPool/v1/step3/src/MemoryPool.cpp -o concurrent_hash_map_bench
+*/
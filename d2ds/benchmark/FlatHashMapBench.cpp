@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "hash-map/FlatHashMap.hpp"
+
+using namespace d2ds;
+
+// FlatHashMap vs std::unordered_map，键值都是 uint64_t，键为随机数
+// 对每个规模 n：插入 n 个键、查找 n 个存在的键 (hit)、查找 n 个不存在的键 (miss)、逐个删除全部键
+// 小规模重复多轮，保证每项至少约 1000 万次操作
+// 用法: flat_hash_map_bench [max_n]（默认 1000 万；1 亿需要约 6GB 内存）
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct Times
+{
+    double insert, hit, miss, erase; // ns/op
+};
+
+template<typename Map>
+Times Run(const std::vector<uint64_t>& keys, const std::vector<uint64_t>& absent, unsigned int rounds)
+{
+    auto ns = [](auto a, auto b) { return std::chrono::duration<double, std::nano>(b - a).count(); };
+    double t_insert = 0, t_hit = 0, t_miss = 0, t_erase = 0;
+    uint64_t found = 0;
+    for (unsigned int r = 0; r < rounds; ++r)
+    {
+        Map map;
+        auto t0 = Clock::now();
+        for (uint64_t k : keys) map[k] = k;
+        auto t1 = Clock::now();
+        for (uint64_t k : keys) found += map.find(k)->second;
+        auto t2 = Clock::now();
+        for (uint64_t k : absent) found += map.count(k);
+        auto t3 = Clock::now();
+        for (uint64_t k : keys) found += map.erase(k);
+        auto t4 = Clock::now();
+        t_insert += ns(t0, t1);
+        t_hit += ns(t1, t2);
+        t_miss += ns(t2, t3);
+        t_erase += ns(t3, t4);
+    }
+    if (found == 42) printf("unlikely\n"); // 防止整段被优化掉
+    double ops = double(keys.size()) * rounds;
+    return {t_insert / ops, t_hit / ops, t_miss / ops, t_erase / ops};
+}
+
+int main(int argc, char* argv[])
+{
+    size_t max_n = argc > 1 ? size_t(atoll(argv[1])) : 10000000;
+    std::mt19937_64 rng(42);
+    for (size_t n = 1000; n <= max_n; n *= 10)
+    {
+        std::vector<uint64_t> keys(n), absent(n);
+        for (auto& k : keys) k = rng() | 1;     // 存在的键都是奇数
+        for (auto& k : absent) k = rng() & ~1ull; // 不存在的键都是偶数
+        unsigned int rounds = n >= 10000000 ? 1 : unsigned(10000000 / n);
+
+        Times f = Run<FlatHashMap<uint64_t, uint64_t>>(keys, absent, rounds);
+        Times s = Run<std::unordered_map<uint64_t, uint64_t>>(keys, absent, rounds);
+        printf("[n=%9zu] ns/op      insert    hit   miss  erase\n", n);
+        printf("  FlatHashMap         %6.1f %6.1f %6.1f %6.1f\n", f.insert, f.hit, f.miss, f.erase);
+        printf("  std::unordered_map  %6.1f %6.1f %6.1f %6.1f\n", s.insert, s.hit, s.miss, s.erase);
+    }
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. benchmark/FlatHashMapBench.cpp -o flat_hash_map_bench
+*/
@@ -0,0 +1,137 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "array/FlatMap.hpp"
+#include "tree/BTreeMap.hpp"
+
+using namespace d2ds;
+
+// 有序 map：FlatMap（有序数组）/ BTreeMap（缓存行 B+ 树）vs std::map，键值都是 int64_t
+//   build  : 插入 n 个随机键（FlatMap 用一次 insert_batch）
+//   lookup : n 次随机查找存在的键
+//   scan   : 完整有序遍历一次 + 1000 次区间扫描（每次约 1000 个元素）
+// 用法: ordered_map_bench [n]（默认 100 万）
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double Ms(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+struct StdMap
+{
+    std::map<int64_t, int64_t> map;
+
+    void build(const std::vector<std::pair<int64_t, int64_t>>& kvs)
+    {
+        for (const auto& kv : kvs) map.emplace(kv.first, kv.second);
+    }
+    int64_t lookup(int64_t k) { return map.find(k)->second; }
+    int64_t scan_all()
+    {
+        int64_t sum = 0;
+        for (const auto& kv : map) sum += kv.second;
+        return sum;
+    }
+    int64_t scan(int64_t lo, int64_t hi)
+    {
+        int64_t sum = 0;
+        for (auto it = map.lower_bound(lo); it != map.end() && it->first < hi; ++it) sum += it->second;
+        return sum;
+    }
+};
+
+struct Flat
+{
+    FlatMap<int64_t, int64_t> map;
+
+    void build(const std::vector<std::pair<int64_t, int64_t>>& kvs) { map.insert_batch(kvs.begin(), kvs.end()); }
+    int64_t lookup(int64_t k) { return map.find(k)->second; }
+    int64_t scan_all()
+    {
+        int64_t sum = 0;
+        for (const auto& kv : map) sum += kv.second;
+        return sum;
+    }
+    int64_t scan(int64_t lo, int64_t hi)
+    {
+        int64_t sum = 0;
+        map.scan(lo, hi, [&sum](int64_t, int64_t v) { sum += v; });
+        return sum;
+    }
+};
+
+struct BTree
+{
+    BTreeMap<int64_t, int64_t> map;
+
+    void build(const std::vector<std::pair<int64_t, int64_t>>& kvs)
+    {
+        for (const auto& kv : kvs) map.insert(kv.first, kv.second);
+    }
+    int64_t lookup(int64_t k) { return map.find(k).value(); }
+    int64_t scan_all()
+    {
+        int64_t sum = 0;
+        for (auto it = map.begin(); it != map.end(); ++it) sum += it.value();
+        return sum;
+    }
+    int64_t scan(int64_t lo, int64_t hi)
+    {
+        int64_t sum = 0;
+        map.scan(lo, hi, [&sum](int64_t, int64_t v) { sum += v; });
+        return sum;
+    }
+};
+
+template<typename Map>
+void Run(const char* name, const std::vector<std::pair<int64_t, int64_t>>& kvs, const std::vector<int64_t>& probes,
+         int64_t key_range)
+{
+    Map* m = new Map;
+    int64_t sink = 0;
+    auto t0 = Clock::now();
+    m->build(kvs);
+    auto t1 = Clock::now();
+    for (int64_t k : probes) sink += m->lookup(k);
+    auto t2 = Clock::now();
+    sink += m->scan_all();
+    int64_t width = key_range / int64_t(kvs.size()) * 1000;
+    for (int i = 0; i < 1000; ++i)
+    {
+        int64_t lo = int64_t(uint64_t(probes[i]) % uint64_t(key_range - width));
+        sink += m->scan(lo, lo + width);
+    }
+    auto t3 = Clock::now();
+    delete m;
+    double n = double(kvs.size());
+    printf("  %-8s build %8.1f ms (%6.1f ns/op), lookup %6.1f ns/op, scan %7.1f ms  (sink=%lld)\n", name, Ms(t0, t1),
+           Ms(t0, t1) * 1e6 / n, Ms(t1, t2) * 1e6 / double(probes.size()), Ms(t2, t3), (long long)sink);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? size_t(atoll(argv[1])) : 1000000;
+    const int64_t key_range = int64_t(1) << 40;
+    std::mt19937_64 rng(42);
+    std::vector<std::pair<int64_t, int64_t>> kvs(n);
+    for (auto& kv : kvs) kv = {int64_t(rng() % uint64_t(key_range)), int64_t(rng() % 1000)};
+    std::vector<int64_t> probes(n);
+    for (auto& p : probes) p = kvs[rng() % n].first;
+
+    printf("n = %zu, BTreeMap<int64_t> 每节点 %u 个键\n", n, BTreeMap<int64_t, int64_t>::kMaxKeys);
+    Run<StdMap>("std::map", kvs, probes, key_range);
+    Run<Flat>("FlatMap", kvs, probes, key_range);
+    Run<BTree>("BTreeMap", kvs, probes, key_range);
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. benchmark/OrderedMapBench.cpp -o ordered_map_bench
+*/
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#include "algorithm/Parallel.hpp"
+#include "array/Vector.hpp"
+
+using namespace d2ds;
+
+// 并行算法扩展性基准：线程数从 1 到 max_threads（默认全部硬件线程），
+// 每种算法在 n 个元素上跑一次，输出耗时和相对 1 线程的加速比。
+// 1 线程时线程池没有后台线程，算法退化为单块串行执行，可以看作串行基线。
+// 用法: parallel_bench [max_threads] [n]
+
+static volatile double g_sink = 0;
+
+template<typename F>
+double Ms(F f)
+{
+    auto begin = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned int max_threads = argc > 1 ? unsigned(atoi(argv[1])) : hw;
+    unsigned int n = argc > 2 ? unsigned(atoi(argv[2])) : (1u << 24);
+
+    Vector<float> src;
+    src.resize_default_init(n);
+    Vector<int> keys;
+    keys.resize_default_init(n);
+    std::mt19937 rng(42);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        src[i] = float(rng() % 1000) / 1000.0f;
+        keys[i] = int(rng());
+    }
+    Vector<float> out;
+    out.resize_default_init(n);
+    std::fill(out.begin(), out.end(), 0.0f); // 先触碰一遍，避免缺页中断算进第一项
+    Vector<int> sorted;
+
+    const char* names[] = {"parallel_for", "transform", "reduce", "inclusive_scan", "sort"};
+    double base[5] = {};
+    printf("n = %u, 硬件线程 %u\n", n, hw);
+    for (unsigned int threads = 1; threads <= max_threads; ++threads)
+    {
+        ThreadPool pool(threads - 1); // 调用线程也参与计算
+        double ms[5];
+        ms[0] = Ms([&] { parallel::parallel_for(pool, out.begin(), out.end(), [](float& x) { x = x * 0.5f + 1.0f; }); });
+        ms[1] = Ms([&] {
+            parallel::transform(pool, src.begin(), src.end(), out.begin(), [](float x) { return std::sqrt(x) * std::exp(-x); });
+        });
+        ms[2] = Ms([&] { g_sink = g_sink + parallel::reduce(pool, src.begin(), src.end(), 0.0f); });
+        ms[3] = Ms([&] { parallel::inclusive_scan(pool, src.begin(), src.end(), out.begin()); });
+        sorted = keys;
+        ms[4] = Ms([&] { parallel::sort(pool, sorted.begin(), sorted.end()); });
+        if (!std::is_sorted(sorted.begin(), sorted.end()))
+        {
+            printf("sort 结果错误\n");
+            return 1;
+        }
+        for (int k = 0; k < 5; ++k)
+        {
+            if (threads == 1) base[k] = ms[k];
+            printf("[%2u 线程] %-15s %8.1f ms  加速比 %.2fx\n", threads, names[k], ms[k], base[k] / ms[k]);
+        }
+    }
+
+    // 参照：标准库串行版本
+    sorted = keys;
+    printf("[std 串行] sort            %8.1f ms\n", Ms([&] { std::sort(sorted.begin(), sorted.end()); }));
+    printf("[std 串行] partial_sum     %8.1f ms\n",
+           Ms([&] { std::partial_sum(src.begin(), src.end(), out.begin()); }));
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. benchmark/ParallelBench.cpp -o parallel_bench
+./parallel_bench            # 1 ~ 全部硬件线程
+./parallel_bench 8 50000000 # 1 ~ 8 线程, 5000 万元素
+*/
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "linked-list/ConcurrentQueue.hpp"
+
+using namespace d2ds;
+
+// 无锁 Michael-Scott 队列 vs 互斥锁保护的 std::queue
+// 生产者:消费者 比例分为均衡 (1:1, 2:2, 4:4) 和倾斜 (1:4, 4:1) 两类，共传递 items 个元素
+// 元素是入队时刻 (ns)，消费者出队时算出排队延迟，统计 p50 / p99
+// 用法: queue_bench [items]
+
+using Clock = std::chrono::steady_clock;
+
+static long long NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+struct LockedQueue
+{
+    std::mutex mutex;
+    std::queue<long long> queue;
+
+    void push(long long v)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(v);
+    }
+    bool try_pop(long long& v)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        v = queue.front();
+        queue.pop();
+        return true;
+    }
+};
+
+struct Result
+{
+    double mops;
+    long long p50;
+    long long p99;
+};
+
+template<typename Queue>
+Result Run(unsigned int producers, unsigned int consumers, unsigned int items)
+{
+    Queue queue;
+    std::atomic<unsigned int> consumed{0};
+    std::vector<std::vector<long long>> latencies(consumers);
+    std::vector<std::thread> threads;
+
+    auto begin = Clock::now();
+    for (unsigned int p = 0; p < producers; ++p)
+    {
+        unsigned int n = items / producers + (p < items % producers ? 1 : 0);
+        threads.emplace_back([&queue, n] {
+            for (unsigned int i = 0; i < n; ++i)
+                queue.push(NowNs());
+        });
+    }
+    for (unsigned int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&, c] {
+            std::vector<long long>& local = latencies[c];
+            local.reserve(items / consumers + 1);
+            long long stamp;
+            while (consumed.load(std::memory_order_relaxed) < items)
+            {
+                if (queue.try_pop(stamp))
+                {
+                    local.push_back(NowNs() - stamp);
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    auto end = Clock::now();
+
+    std::vector<long long> all;
+    all.reserve(items);
+    for (auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+    std::sort(all.begin(), all.end());
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    return {items / seconds / 1e6, all[all.size() / 2], all[all.size() * 99 / 100]};
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int items = argc > 1 ? unsigned(atoi(argv[1])) : 2000000;
+    printf("元素 %u 个, 硬件线程 %u\n", items, std::thread::hardware_concurrency());
+
+    const unsigned int configs[][2] = {{1, 1}, {2, 2}, {4, 4}, {1, 4}, {4, 1}};
+    for (const auto& cfg : configs)
+    {
+        Result a = Run<ConcurrentQueue<long long>>(cfg[0], cfg[1], items);
+        Result b = Run<LockedQueue>(cfg[0], cfg[1], items);
+        printf("[%u:%u] ConcurrentQueue %7.2f Mops/s p50 %8lld ns p99 %9lld ns | "
+               "mutex + std::queue %7.2f Mops/s p50 %8lld ns p99 %9lld ns\n",
+               cfg[0], cfg[1], a.mops, a.p50, a.p99, b.mops, b.p50, b.p99);
+    }
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. benchmark/QueueBench.cpp ../MemoryPool/v1/step3/src/MemoryPool.cpp -o queue_bench
+*/
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include "array/SPSCRingBuffer.hpp"
+
+using namespace d2ds;
+
+// 一个生产者线程向一个消费者线程传递 items 个 uint64_t（默认 5000 万），比较吞吐：
+//   SPSCRingBuffer 逐个 : try_push / try_pop
+//   SPSCRingBuffer 批量 : push_n / pop_n，每批最多 kBatch 个
+//   mutex + std::queue  : 原来 I/O 线程交接任务的方式
+// 消费者对收到的值求和，与 0 + 1 + ... + (items - 1) 比对
+// 用法: ring_buffer_bench [items]
+
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned int kCapacity = 4096;
+constexpr size_t kBatch = 64;
+
+using Ring = SPSCRingBuffer<uint64_t, kCapacity>;
+
+struct LockedQueue
+{
+    std::mutex mutex;
+    std::queue<uint64_t> queue;
+
+    void push(uint64_t v)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(v);
+    }
+    bool try_pop(uint64_t& v)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        v = queue.front();
+        queue.pop();
+        return true;
+    }
+};
+
+template<typename Produce, typename Consume>
+void Run(const char* name, uint64_t items, Produce produce, Consume consume)
+{
+    auto begin = Clock::now();
+    std::thread producer(produce);
+    uint64_t sum = consume();
+    producer.join();
+    auto end = Clock::now();
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    bool ok = sum == items * (items - 1) / 2;
+    printf("  %-22s %8.1f ms  %7.2f Mmsg/s  %s\n", name, seconds * 1e3, double(items) / seconds / 1e6,
+           ok ? "" : "结果不一致!");
+}
+
+int main(int argc, char* argv[])
+{
+    uint64_t items = argc > 1 ? uint64_t(atoll(argv[1])) : 50000000;
+    printf("消息 %llu 个, 环形队列容量 %u, 批大小 %zu, 硬件线程 %u\n", (unsigned long long)items, kCapacity, kBatch,
+           std::thread::hardware_concurrency());
+
+    {
+        auto ring = std::make_unique<Ring>();
+        Run(
+            "SPSCRingBuffer", items,
+            [&] {
+                for (uint64_t i = 0; i < items; ++i)
+                    while (!ring->try_push(i)) std::this_thread::yield();
+            },
+            [&] {
+                uint64_t sum = 0, v;
+                for (uint64_t i = 0; i < items; ++i)
+                {
+                    while (!ring->try_pop(v)) std::this_thread::yield();
+                    sum += v;
+                }
+                return sum;
+            });
+    }
+    {
+        auto ring = std::make_unique<Ring>();
+        Run(
+            "SPSCRingBuffer batch", items,
+            [&] {
+                uint64_t buf[kBatch];
+                for (uint64_t next = 0; next < items;)
+                {
+                    size_t n = items - next < kBatch ? size_t(items - next) : kBatch;
+                    for (size_t k = 0; k < n; ++k) buf[k] = next + k;
+                    size_t pushed = ring->push_n(buf, n);
+                    // 只放下了一部分：剩下的下一轮重新生成
+                    if (pushed == 0) std::this_thread::yield();
+                    next += pushed;
+                }
+            },
+            [&] {
+                uint64_t sum = 0, buf[kBatch];
+                for (uint64_t got = 0; got < items;)
+                {
+                    size_t n = ring->pop_n(buf, kBatch);
+                    if (n == 0) std::this_thread::yield();
+                    for (size_t k = 0; k < n; ++k) sum += buf[k];
+                    got += n;
+                }
+                return sum;
+            });
+    }
+    {
+        LockedQueue queue;
+        Run(
+            "mutex + std::queue", items,
+            [&] {
+                for (uint64_t i = 0; i < items; ++i) queue.push(i);
+            },
+            [&] {
+                uint64_t sum = 0, v;
+                for (uint64_t i = 0; i < items; ++i)
+                {
+                    while (!queue.try_pop(v)) std::this_thread::yield();
+                    sum += v;
+                }
+                return sum;
+            });
+    }
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. benchmark/RingBufferBench.cpp -o ring_buffer_bench
+*/
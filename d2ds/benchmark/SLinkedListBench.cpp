@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "linked-list/SLinkedList.hpp"
+
+using namespace d2ds;
+
+// 链表 push/pop 基准：对比默认的 malloc/free 与 PoolAllocator
+// 每轮先 push_back n 个节点，再全部 pop_front，模拟队列式的节点反复申请/释放
+
+template<typename Allocator>
+double BenchmarkPushPop(unsigned int n, unsigned int rounds)
+{
+    SLinkedList<long, Allocator> list;
+    long sum = 0;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (unsigned int r = 0; r < rounds; ++r)
+    {
+        for (unsigned int i = 0; i < n; ++i)
+            list.push_back(i);
+        while (!list.empty())
+        {
+            sum += list.front();
+            list.pop_front();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    if (sum == 42) printf("unlikely\n"); // 防止整段被优化掉
+    return std::chrono::duration<double, std::nano>(end - begin).count() / (2.0 * n * rounds);
+}
+
+// 整表构建/遍历/析构：对比逐节点分配与链表自有的 Slab（int 可平凡析构，析构时整块归还）
+// 先用同一分配器打乱一遍堆（交错申请释放），让逐节点分配的节点在内存中不连续
+template<typename Allocator>
+void BenchmarkBuildDestroy(const char* name, unsigned int n)
+{
+    {
+        SLinkedList<long, Allocator> a, b;
+        for (unsigned int i = 0; i < n; ++i) { a.push_back(i); b.push_back(i); }
+        for (unsigned int i = 0; i < n / 2; ++i) a.pop_front();
+    }
+    auto* list = new SLinkedList<long, Allocator>;
+    long sum = 0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (unsigned int i = 0; i < n; ++i)
+        list->push_back(i);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < 10; ++r)
+        for (auto it = list->begin(); it != list->end(); ++it)
+            sum += *it;
+    auto t2 = std::chrono::high_resolution_clock::now();
+    delete list;
+    auto t3 = std::chrono::high_resolution_clock::now();
+    auto ns = [](auto a, auto b) { return std::chrono::duration<double, std::nano>(b - a).count(); };
+    printf("[SLinkedList<%-14s>] %u 个节点: push_back %.2f ns/op, 遍历 %.2f ns/elem, 析构 %.3f ms (sum=%ld)\n",
+           name, n, ns(t0, t1) / n, ns(t1, t2) / (10.0 * n), ns(t2, t3) / 1e6, sum);
+}
+
+// 排序 n 个随机整数：SLinkedList::sort（原地归并，只改链接） vs 拷到 vector 里 std::sort 再写回 vs std::list::sort
+void BenchmarkSort(unsigned int n)
+{
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    std::mt19937 rng(42);
+    std::vector<int> values(n);
+    for (auto& v : values) v = int(rng());
+
+    double in_place, via_vector, std_list;
+    {
+        SLinkedList<int> list;
+        list.insert_after(list.before_begin(), values.begin(), values.end());
+        auto t0 = std::chrono::high_resolution_clock::now();
+        list.sort();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        in_place = ms(t0, t1);
+    }
+    {
+        SLinkedList<int> list;
+        list.insert_after(list.before_begin(), values.begin(), values.end());
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::vector<int> tmp;
+        tmp.reserve(list.size());
+        for (auto it = list.begin(); it != list.end(); ++it) tmp.push_back(*it);
+        std::sort(tmp.begin(), tmp.end());
+        auto src = tmp.begin();
+        for (auto it = list.begin(); it != list.end(); ++it) *it = *src++;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        via_vector = ms(t0, t1);
+    }
+    {
+        std::list<int> list(values.begin(), values.end());
+        auto t0 = std::chrono::high_resolution_clock::now();
+        list.sort();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std_list = ms(t0, t1);
+    }
+    printf("[sort] %u 个节点: SLinkedList::sort %.1f ms, 拷到 vector 排序再写回 %.1f ms, std::list::sort %.1f ms\n",
+           n, in_place, via_vector, std_list);
+}
+
+int main()
+{
+    // 参数：每轮节点数，轮数
+    const unsigned int sizes[] = {64, 4096, 1000000};
+    for (unsigned int n : sizes)
+    {
+        unsigned int rounds = 10000000 / n;
+        double heap = BenchmarkPushPop<DefaultAllocator>(n, rounds);
+        double pool = BenchmarkPushPop<PoolAllocator>(n, rounds);
+        printf("[SLinkedList] 每轮 %u 个节点, %u 轮: malloc %.2f ns/op, PoolAllocator %.2f ns/op (%.2fx)\n",
+               n, rounds, heap, pool, heap / pool);
+    }
+
+    for (unsigned int n : {100000u, 4000000u})
+    {
+        BenchmarkBuildDestroy<DefaultAllocator>("malloc", n);
+        BenchmarkBuildDestroy<PoolAllocator>("PoolAllocator", n);
+        BenchmarkBuildDestroy<Slab<>>("Slab<>", n);
+    }
+
+    BenchmarkSort(10000000);
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. benchmark/SLinkedListBench.cpp ../MemoryPool/v1/step3/src/MemoryPool.cpp -o slist_bench
+*/
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "array/Vector.hpp"
+
+using namespace d2ds;
+
+// SIMD 内核基准：同一份内核的标量版本 (run_scalar) 与运行时分派版本对比
+// 数组长度分别取 L2 内 (64K) 与远超缓存 (16M)，后者主要受内存带宽限制
+
+static volatile double g_sink = 0;
+
+template<typename F>
+double NsPerElement(size_t n, int rounds, F f)
+{
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r) f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / (double(n) * rounds);
+}
+
+template<typename T>
+void BenchmarkType(const char* name, unsigned int n)
+{
+    Vector<T> a, b, out;
+    a.resize_default_init(n);
+    b.resize_default_init(n);
+    out.resize_default_init(n);
+    for (unsigned int i = 0; i < n; ++i) { a[i] = T(i % 97); b[i] = T(i % 89); }
+    int rounds = int(200000000ull / n) + 1;
+    Vector<T> a_copy = a; // equal 需要两块内容相同的不同内存，否则编译器可能直接判定相等
+    const T* pa = a.begin();
+    const T* pc = a_copy.begin();
+    const T* pb = b.begin();
+    T* po = out.begin();
+
+    using namespace simd::detail;
+    struct Row { const char* op; double scalar; double simd; };
+    Row rows[] = {
+        {"add", NsPerElement(n, rounds, [&] { run_scalar<Elementwise<AddOp>>(pa, pb, po, size_t(n)); }),
+                NsPerElement(n, rounds, [&] { simd::add(pa, pb, po, n); })},
+        {"mul", NsPerElement(n, rounds, [&] { run_scalar<Elementwise<MulOp>>(pa, pb, po, size_t(n)); }),
+                NsPerElement(n, rounds, [&] { simd::mul(pa, pb, po, n); })},
+        {"fma", NsPerElement(n, rounds, [&] { run_scalar<Fma>(pa, pb, pa, po, size_t(n)); }),
+                NsPerElement(n, rounds, [&] { simd::fma(pa, pb, pa, po, n); })},
+        {"dot", NsPerElement(n, rounds, [&] { g_sink = g_sink + run_scalar<Dot>(pa, pb, size_t(n)); }),
+                NsPerElement(n, rounds, [&] { g_sink = g_sink + simd::dot(pa, pb, n); })},
+        {"sum", NsPerElement(n, rounds, [&] { g_sink = g_sink + run_scalar<Sum>(pa, size_t(n)); }),
+                NsPerElement(n, rounds, [&] { g_sink = g_sink + simd::sum(pa, n); })},
+        {"max", NsPerElement(n, rounds, [&] { g_sink = g_sink + run_scalar<MinMax<false>>(pa, size_t(n)); }),
+                NsPerElement(n, rounds, [&] { g_sink = g_sink + simd::max(pa, n); })},
+        {"equal", NsPerElement(n, rounds, [&] { g_sink = g_sink + run_scalar<Equal>(pa, pc, size_t(n)); }),
+                  NsPerElement(n, rounds, [&] { g_sink = g_sink + simd::equal(pa, pc, n); })},
+    };
+    for (const Row& r : rows)
+        printf("[%-6s n=%-9u] %-5s 标量 %.3f ns/elem, %s %.3f ns/elem (%.1fx)\n", name, n, r.op, r.scalar,
+               simd::isa_name(simd::cpu_isa()), r.simd, r.scalar / r.simd);
+}
+
+// 表达式模板：r = a + b - c
+// 逐个运算符求值（每个运算符一个临时 Vector、一遍内存扫描）与融合求值对比
+template<typename T>
+void BenchmarkExpr(const char* name, unsigned int n)
+{
+    Vector<T> a, b, c;
+    a.resize_default_init(n);
+    b.resize_default_init(n);
+    c.resize_default_init(n);
+    for (unsigned int i = 0; i < n; ++i) { a[i] = T(i % 97); b[i] = T(i % 89); c[i] = T(i % 7); }
+    int rounds = int(200000000ull / n) + 1;
+
+    double eager = NsPerElement(n, rounds, [&] {
+        Vector<T> t1, r;
+        t1.resize_default_init(n);
+        simd::add(a.begin(), b.begin(), t1.begin(), n);
+        r.resize_default_init(n);
+        simd::sub(t1.begin(), c.begin(), r.begin(), n);
+        g_sink = g_sink + r[n - 1];
+    });
+    double fused = NsPerElement(n, rounds, [&] {
+        Vector<T> r = a + b - c;
+        g_sink = g_sink + r[n - 1];
+    });
+    printf("[%-6s n=%-9u] a+b-c 逐个运算符 %.3f ns/elem, 表达式模板 %.3f ns/elem (%.1fx)\n", name, n, eager,
+           fused, eager / fused);
+}
+
+int main()
+{
+    const unsigned int sizes[] = {1u << 16, 1u << 24};
+    for (unsigned int n : sizes)
+    {
+        BenchmarkType<float>("float", n);
+        BenchmarkType<int>("int", n);
+        BenchmarkType<double>("double", n);
+    }
+    for (unsigned int n : sizes)
+    {
+        BenchmarkExpr<float>("float", n);
+        BenchmarkExpr<int>("int", n);
+    }
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. benchmark/SimdBench.cpp -o simd_bench
+*/
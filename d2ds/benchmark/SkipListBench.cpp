@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "linked-list/ConcurrentSkipList.hpp"
+
+using namespace d2ds;
+
+// 无锁跳表 vs 互斥锁保护的 std::map：线程数 1, 2, 4, ... 直到 max_threads（默认 32）
+// 键空间 [0, kKeys)，预先插入一半；每个线程做 ops 次随机操作：
+// 读多写少 = 90% 查找 / 5% 插入 / 5% 删除，写多 = 50% 查找 / 25% 插入 / 25% 删除
+// 用法: skip_list_bench [max_threads] [ops per thread]
+
+static const int kKeys = 1 << 20;
+
+struct LockedMap
+{
+    std::mutex mutex;
+    std::map<int, int> map;
+
+    bool insert(int k, int v)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.emplace(k, v).second;
+    }
+    bool erase(int k)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.erase(k) == 1;
+    }
+    bool contains(int k)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.count(k) == 1;
+    }
+};
+
+template<typename Map>
+double MopsPerSecond(Map& map, unsigned int threads, unsigned int ops, unsigned int write_percent)
+{
+    std::vector<std::thread> workers;
+    std::atomic<long> hits{0};
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t] {
+            std::mt19937 rng(t * 7919 + 1);
+            long local = 0;
+            for (unsigned int i = 0; i < ops; ++i)
+            {
+                int key = int(rng() % kKeys);
+                unsigned int dice = rng() % 100;
+                if (dice < write_percent / 2)
+                    local += map.insert(key, key);
+                else if (dice < write_percent)
+                    local += map.erase(key);
+                else
+                    local += map.contains(key);
+            }
+            hits += local;
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    return double(threads) * ops / seconds / 1e6;
+}
+
+template<typename Map>
+void Fill(Map& map)
+{
+    for (int k = 0; k < kKeys; k += 2)
+        map.insert(k, k);
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int max_threads = argc > 1 ? unsigned(atoi(argv[1])) : 32;
+    unsigned int ops = argc > 2 ? unsigned(atoi(argv[2])) : 200000;
+    printf("键空间 %d, 每线程 %u 次操作, 硬件线程 %u\n", kKeys, ops, std::thread::hardware_concurrency());
+
+    for (unsigned int write_percent : {10u, 50u})
+    {
+        printf("---- 写操作占 %u%% ----\n", write_percent);
+        for (unsigned int threads = 1; threads <= max_threads; threads *= 2)
+        {
+            ConcurrentSkipList<int, int> skip;
+            LockedMap locked;
+            Fill(skip);
+            Fill(locked);
+            double a = MopsPerSecond(skip, threads, ops, write_percent);
+            double b = MopsPerSecond(locked, threads, ops, write_percent);
+            printf("[%2u 线程] ConcurrentSkipList %7.2f Mops/s, mutex + std::map %7.2f Mops/s (%.2fx)\n",
+                   threads, a, b, a / b);
+        }
+    }
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. benchmark/SkipListBench.cpp ../MemoryPool/v1/step3/src/MemoryPool.cpp -o skip_list_bench
+*/
@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstdio>
+
+#include "array/SmallVector.hpp"
+#include "array/Vector.hpp"
+
+using namespace d2ds;
+
+// SmallVector 基准：反复创建/销毁大量小容器，对比分配次数与耗时
+
+struct CountingAllocator
+{
+    static unsigned long count;
+    static void* allocate(size_t bytes) { ++count; return DefaultAllocator::allocate(bytes); }
+    static void deallocate(void* addr, size_t bytes) { DefaultAllocator::deallocate(addr, bytes); }
+};
+unsigned long CountingAllocator::count = 0;
+
+// 创建 nvec 个容器，第 i 个容器的元素个数为 1 + i % max_len
+template<typename Vec>
+void BenchmarkSmall(const char* name, unsigned int nvec, unsigned int max_len)
+{
+    CountingAllocator::count = 0;
+    long sum = 0;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (unsigned int i = 0; i < nvec; ++i)
+    {
+        Vec v;
+        unsigned int len = 1 + i % max_len;
+        for (unsigned int k = 0; k < len; ++k)
+            v.push_back(int(k));
+        sum += v[len - 1];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+    printf("[%-22s] %u 个容器, 长度 1~%u: 分配 %lu 次, 耗时 %.1f ms (sum=%ld)\n",
+           name, nvec, max_len, CountingAllocator::count, ms, sum);
+}
+
+int main()
+{
+    const unsigned int nvec = 5000000;
+    // 全部落在内联容量以内
+    BenchmarkSmall<Vector<int, CountingAllocator>>("Vector<int>", nvec, 8);
+    BenchmarkSmall<SmallVector<int, 8, CountingAllocator>>("SmallVector<int, 8>", nvec, 8);
+    // 部分容器溢出到堆
+    BenchmarkSmall<Vector<int, CountingAllocator>>("Vector<int>", nvec, 16);
+    BenchmarkSmall<SmallVector<int, 8, CountingAllocator>>("SmallVector<int, 8>", nvec, 16);
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. benchmark/SmallVectorBench.cpp -o small_vector_bench
+*/
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "array/StaticSearch.hpp"
+#include "array/Vector.hpp"
+
+using namespace d2ds;
+
+// 静态有序数组上的 lower_bound：n 个有序 int32 键，m 次随机查询（默认都是 1000 万）
+//   std::lower_bound : 在 d2ds::Vector 上二分
+//   Eytzinger        : 单个查询，无分支 + 预取
+//   Eytzinger batch  : lower_bound_batch，每 8 个查询交错推进
+//   StaticBTree      : 每块一条缓存行，块内 SIMD 比较
+// 所有结构返回同一个有序下标，结果累加进 sink 并互相校验
+// 用法: static_search_bench [n] [m]
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double Ms(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+template<typename F>
+uint64_t Run(const char* name, size_t m, F f)
+{
+    auto t0 = Clock::now();
+    uint64_t sink = f();
+    auto t1 = Clock::now();
+    printf("  %-18s %8.1f ms  %6.1f ns/query  (sink=%llu)\n", name, Ms(t0, t1), Ms(t0, t1) * 1e6 / double(m),
+           (unsigned long long)sink);
+    return sink;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int n = argc > 1 ? unsigned(atoll(argv[1])) : 10000000;
+    size_t m = argc > 2 ? size_t(atoll(argv[2])) : 10000000;
+    std::mt19937 rng(42);
+
+    std::vector<int32_t> keys(n);
+    for (auto& k : keys) k = int32_t(rng() >> 1);
+    std::sort(keys.begin(), keys.end());
+    Vector<int32_t> sorted;
+    sorted.reserve(n);
+    for (int32_t k : keys) sorted.push_back(k);
+    std::vector<int32_t> queries(m);
+    for (auto& q : queries) q = int32_t(rng() >> 1);
+
+    auto t0 = Clock::now();
+    EytzingerArray<int32_t> eytzinger(sorted);
+    auto t1 = Clock::now();
+    StaticBTree<int32_t> btree(sorted);
+    auto t2 = Clock::now();
+    printf("n = %u, m = %zu, 构建: Eytzinger %.1f ms, StaticBTree %.1f ms\n", n, m, Ms(t0, t1), Ms(t1, t2));
+
+    uint64_t expect = Run("std::lower_bound", m, [&] {
+        uint64_t sum = 0;
+        for (int32_t q : queries) sum += uint64_t(std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin());
+        return sum;
+    });
+    uint64_t got[3];
+    got[0] = Run("Eytzinger", m, [&] {
+        uint64_t sum = 0;
+        for (int32_t q : queries) sum += eytzinger.lower_bound(q);
+        return sum;
+    });
+    got[1] = Run("Eytzinger batch", m, [&] {
+        std::vector<unsigned int> out(m);
+        eytzinger.lower_bound_batch(queries.data(), out.data(), m);
+        uint64_t sum = 0;
+        for (unsigned int r : out) sum += r;
+        return sum;
+    });
+    got[2] = Run("StaticBTree", m, [&] {
+        uint64_t sum = 0;
+        for (int32_t q : queries) sum += btree.lower_bound(q);
+        return sum;
+    });
+    for (uint64_t g : got)
+    {
+        if (g != expect)
+        {
+            printf("结果不一致!\n");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. benchmark/StaticSearchBench.cpp -o static_search_bench
+*/
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include "array/Vector.hpp"
+#include "linked-list/SLinkedList.hpp"
+#include "linked-list/UnrolledList.hpp"
+
+using namespace d2ds;
+
+// 展开链表基准：与 SLinkedList（每节点一个元素）、Vector（连续数组）对比
+//   - push_back：顺序追加 n 个元素
+//   - 遍历：range-for 求和，重复多轮
+//   - 随机位置插入：在长度为 n 的容器中随机位置插入 m 个元素
+//     SLinkedList 需要从头走到位置再 insert_after；Vector 没有 insert，用 push_back + std::rotate 模拟
+
+static volatile long g_sink = 0;
+
+template<typename F>
+double Ms(F f)
+{
+    auto begin = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+template<typename C>
+long SumAll(C& c)
+{
+    long sum = 0;
+    for (auto& x : c)
+        sum += x;
+    return sum;
+}
+
+void Benchmark(unsigned int n, unsigned int m)
+{
+    const unsigned int rounds = std::max(1u, 50000000u / n);
+    SLinkedList<int> slist;
+    Vector<int> vec;
+    UnrolledList<int> ulist;
+
+    double push[3] = {
+        Ms([&] { for (unsigned int i = 0; i < n; ++i) slist.push_back(int(i)); }),
+        Ms([&] { for (unsigned int i = 0; i < n; ++i) vec.push_back(int(i)); }),
+        Ms([&] { for (unsigned int i = 0; i < n; ++i) ulist.push_back(int(i)); }),
+    };
+    double iter[3] = {
+        Ms([&] { for (unsigned int r = 0; r < rounds; ++r) g_sink = g_sink + SumAll(slist); }),
+        Ms([&] { for (unsigned int r = 0; r < rounds; ++r) g_sink = g_sink + SumAll(vec); }),
+        Ms([&] { for (unsigned int r = 0; r < rounds; ++r) g_sink = g_sink + SumAll(ulist); }),
+    };
+
+    std::mt19937 rng(1);
+    std::vector<unsigned int> pos(m);
+    for (unsigned int k = 0; k < m; ++k)
+        pos[k] = rng() % (n + k);
+    double insert[3] = {
+        Ms([&] {
+            for (unsigned int k = 0; k < m; ++k)
+            {
+                if (pos[k] == 0) { slist.push_front(int(k)); continue; }
+                auto it = slist.begin();
+                for (unsigned int i = 1; i < pos[k]; ++i) ++it;
+                slist.insert_after(it, int(k));
+            }
+        }),
+        Ms([&] {
+            for (unsigned int k = 0; k < m; ++k)
+            {
+                vec.push_back(int(k));
+                std::rotate(vec.begin() + pos[k], vec.end() - 1, vec.end());
+            }
+        }),
+        Ms([&] { for (unsigned int k = 0; k < m; ++k) ulist.insert(pos[k], int(k)); }),
+    };
+    if (SumAll(slist) != SumAll(vec) || SumAll(vec) != SumAll(ulist))
+        printf("结果不一致\n");
+
+    const char* names[3] = {"SLinkedList", "Vector", "UnrolledList"};
+    printf("n = %u (遍历 %u 轮, 随机插入 %u 次), UnrolledList 节点数 %u\n", n, rounds, m, ulist.node_count());
+    for (int k = 0; k < 3; ++k)
+        printf("  [%-12s] push_back %.2f ns/op, 遍历 %.3f ns/elem, 随机插入 %.1f ns/op\n", names[k],
+               push[k] * 1e6 / n, iter[k] * 1e6 / (double(n) * rounds), insert[k] * 1e6 / m);
+}
+
+int main()
+{
+    Benchmark(10000, 10000);
+    Benchmark(1000000, 2000);
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. benchmark/UnrolledListBench.cpp ../MemoryPool/v1/step3/src/MemoryPool.cpp -o unrolled_list_bench
+*/
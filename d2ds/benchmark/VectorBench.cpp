@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "array/Vector.hpp"
+
+using namespace d2ds;
+
+// Vector 增长基准：从空开始 push_back 到 n 个元素，统计总耗时（包含所有扩容搬迁）
+
+template<typename Vec, typename Make>
+double BenchmarkGrowth(unsigned int n, Make make)
+{
+    auto begin = std::chrono::high_resolution_clock::now();
+    {
+        Vec v;
+        for (unsigned int i = 0; i < n; ++i)
+            v.push_back(make(i));
+        if (v.size() != n) printf("size mismatch\n");
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+// 统计分配次数的分配器，用来观察 push/pop 交替时是否反复扩缩容
+struct CountingAllocator
+{
+    static unsigned long count;
+    static void* allocate(size_t bytes) { ++count; return DefaultAllocator::allocate(bytes); }
+    static void deallocate(void* addr, size_t bytes) { DefaultAllocator::deallocate(addr, bytes); }
+};
+unsigned long CountingAllocator::count = 0;
+
+// 在收缩边界附近反复 pop/push，返回期间发生的分配次数
+unsigned long ChurnAllocations(unsigned int base, unsigned int rounds)
+{
+    Vector<int, CountingAllocator> v;
+    for (unsigned int i = 0; i < base; ++i)
+        v.push_back(i);
+    CountingAllocator::count = 0;
+    for (unsigned int r = 0; r < rounds; ++r)
+    {
+        for (unsigned int i = 0; i < base / 2; ++i) v.pop_back();
+        for (unsigned int i = 0; i < base / 2; ++i) v.push_back(i);
+    }
+    return CountingAllocator::count;
+}
+
+int main(int argc, char** argv)
+{
+    // 参数：int 元素个数（默认 1 亿），string 元素个数为其 1/10
+    unsigned int n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000000;
+
+    auto make_int = [](unsigned int i) { return int(i); };
+    double d2ds_int = BenchmarkGrowth<Vector<int>>(n, make_int);
+    double std_int = BenchmarkGrowth<std::vector<int>>(n, make_int);
+    printf("[Vector<int>]         push_back 到 %u: d2ds %.1f ms, std::vector %.1f ms\n", n, d2ds_int, std_int);
+
+    // 超过 SSO 长度的字符串：旧实现每次扩容都会深拷贝所有字符串
+    auto make_str = [](unsigned int i) { return std::string("a reasonably long string #") + std::to_string(i); };
+    double d2ds_str = BenchmarkGrowth<Vector<std::string>>(n / 10, make_str);
+    double std_str = BenchmarkGrowth<std::vector<std::string>>(n / 10, make_str);
+    printf("[Vector<std::string>] push_back 到 %u: d2ds %.1f ms, std::vector %.1f ms\n", n / 10, d2ds_str, std_str);
+
+    // 1025 个元素时容量为 2048，反复弹出/压入一半元素
+    printf("[Vector<int>]         push/pop 交替 100000 轮: 分配 %lu 次\n", ChurnAllocations(1025, 100000));
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. benchmark/VectorBench.cpp -o vector_bench
+*/
@@ -0,0 +1,196 @@
+#ifndef EPOCH_HPP_D2DS
+#define EPOCH_HPP_D2DS
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "common/common.hpp"
+
+namespace d2ds {
+namespace epoch {
+
+// 基于纪元的内存回收 (Epoch-Based Reclamation)，供无锁容器安全释放已摘除的节点：
+//   - 访问共享结构前用 Guard 把当前线程“钉”在全局纪元 E 上（可嵌套，只有最外层生效）；
+//   - 节点从结构中摘除后调用 retire()，按摘除后读到的全局纪元 E 记账，暂不释放；
+//   - 所有处于临界区的线程都已观察到 E 时，全局纪元才能推进到 E+1；
+//     到 E+2 时，摘除前就进入临界区、可能还持有该节点的线程必然都已离开，节点可以释放。
+// 代价：读路径只有一次 seq_cst 写和一次重读；若某个线程长期停在临界区内，回收会被推迟（只会多占内存，不会提前释放）。
+//
+// 线程退出时未到期的节点移交全局“孤儿”列表，由之后回收的线程释放；删除函数运行在任意线程上。
+
+namespace detail {
+
+struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+    uint64_t epoch;
+};
+
+struct alignas(CACHE_LINE_SIZE) Record {
+    std::atomic<uint64_t> state{0}; // (纪元 << 1) | 是否在临界区
+    std::atomic<bool> in_use{false};
+    Record* next = nullptr;
+
+    // 以下只由占用该记录的线程访问
+    unsigned int depth = 0;
+    unsigned int retired_since_collect = 0;
+    std::vector<Retired> limbo;
+};
+
+class Domain {
+public:
+    // 每次 retire 累计这么多个节点后尝试推进纪元并回收
+    static constexpr unsigned int kCollectInterval = 64;
+
+    // 不析构：线程局部的 Handle 可能在静态对象析构之后才退出
+    static Domain& instance() {
+        static Domain* domain = new Domain;
+        return *domain;
+    }
+
+    Record* acquire() {
+        for (Record* r = _records.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed) &&
+                r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return r;
+        }
+        Record* r = new Record;
+        r->in_use.store(true, std::memory_order_relaxed);
+        Record* head = _records.load(std::memory_order_relaxed);
+        do {
+            r->next = head;
+        } while (!_records.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+        return r;
+    }
+
+    void release(Record* r) {
+        if (!r->limbo.empty()) {
+            std::lock_guard<std::mutex> lock(_orphan_mutex);
+            _orphans.insert(_orphans.end(), r->limbo.begin(), r->limbo.end());
+            _orphan_count_hint.store(_orphans.size(), std::memory_order_relaxed);
+            r->limbo.clear();
+        }
+        r->state.store(0, std::memory_order_release);
+        r->in_use.store(false, std::memory_order_release);
+    }
+
+    void pin(Record& r) {
+        if (r.depth++ != 0) return;
+        uint64_t e = _epoch.load(std::memory_order_seq_cst);
+        while (true) {
+            r.state.store((e << 1) | 1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint64_t now = _epoch.load(std::memory_order_seq_cst);
+            if (now == e) break;
+            e = now;
+        }
+    }
+
+    void unpin(Record& r) {
+        if (--r.depth != 0) return;
+        r.state.store(r.state.load(std::memory_order_relaxed) & ~uint64_t(1), std::memory_order_release);
+    }
+
+    void retire(Record& r, void* ptr, void (*deleter)(void*)) {
+        r.limbo.push_back({ptr, deleter, _epoch.load(std::memory_order_seq_cst)});
+        if (++r.retired_since_collect >= kCollectInterval) {
+            r.retired_since_collect = 0;
+            collect(r);
+        }
+    }
+
+    // 所有在临界区内的线程都已处于当前纪元时推进一步
+    bool try_advance() {
+        uint64_t e = _epoch.load(std::memory_order_seq_cst);
+        for (Record* r = _records.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            uint64_t s = r->state.load(std::memory_order_seq_cst);
+            if ((s & 1) && (s >> 1) != e)
+                return false;
+        }
+        return _epoch.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+    }
+
+    void collect(Record& r) {
+        try_advance();
+        uint64_t e = _epoch.load(std::memory_order_seq_cst);
+        free_expired(r.limbo, e);
+        if (_orphan_count_hint.load(std::memory_order_relaxed) != 0 && _orphan_mutex.try_lock()) {
+            free_expired(_orphans, e);
+            _orphan_count_hint.store(_orphans.size(), std::memory_order_relaxed);
+            _orphan_mutex.unlock();
+        }
+    }
+
+    uint64_t epoch() const { return _epoch.load(std::memory_order_relaxed); }
+
+private:
+    // 孤儿列表混有多个线程的节点，纪元不保证有序，逐个判断
+    static void free_expired(std::vector<Retired>& list, uint64_t e) {
+        std::vector<Retired> expired;
+        size_t kept = 0;
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (list[i].epoch + 2 <= e)
+                expired.push_back(list[i]);
+            else
+                list[kept++] = list[i];
+        }
+        if (expired.empty()) return;
+        list.resize(kept);
+        for (const Retired& item : expired) // 删除函数可能再次 retire，先从列表中拿出来
+            item.deleter(item.ptr);
+    }
+
+    std::atomic<uint64_t> _epoch{0};
+    std::atomic<Record*> _records{nullptr};
+    std::mutex _orphan_mutex;
+    std::vector<Retired> _orphans;
+    std::atomic<size_t> _orphan_count_hint{0};
+};
+
+struct Handle {
+    Record* record;
+    Handle(): record(Domain::instance().acquire()) {}
+    ~Handle() { Domain::instance().release(record); }
+};
+
+inline Record& local_record() {
+    thread_local Handle handle;
+    return *handle.record;
+}
+
+} // namespace detail
+
+// 临界区守卫：持有期间读到的节点不会被释放
+class Guard {
+public:
+    Guard(): _record(detail::local_record()) { detail::Domain::instance().pin(_record); }
+    ~Guard() { detail::Domain::instance().unpin(_record); }
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+private:
+    detail::Record& _record;
+};
+
+// ptr 必须已经从共享结构中摘除（新进入临界区的线程不可能再读到它）
+inline void retire(void* ptr, void (*deleter)(void*)) {
+    detail::Domain::instance().retire(detail::local_record(), ptr, deleter);
+}
+
+template<typename T>
+void retire(T* ptr) {
+    retire(static_cast<void*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+}
+
+// 主动推进纪元并释放本线程已到期的节点（测试或空闲时调用）
+inline void collect() {
+    detail::Domain::instance().collect(detail::local_record());
+}
+
+} // namespace epoch
+} // namespace d2ds
+
+#endif
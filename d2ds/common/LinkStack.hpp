@@ -0,0 +1,110 @@
+#ifndef LINK_STACK_HPP_D2DS
+#define LINK_STACK_HPP_D2DS
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+#include "common/common.hpp"
+
+namespace d2ds {
+
+    // 无锁栈使用的嵌入式链接：与 SinglyLink 一样嵌在对象里，只是 next 是原子的，
+    // 因为出栈线程可能在对象被别人弹出、改写的同时读取它的 next
+    struct AtomicSinglyLink{
+        std::atomic<AtomicSinglyLink*> next{nullptr};
+
+        AtomicSinglyLink()=default;
+        AtomicSinglyLink(const AtomicSinglyLink&){}
+        AtomicSinglyLink& operator=(const AtomicSinglyLink&){ return *this; }
+    };
+
+    // 直接以链接为元素的无锁栈（Treiber 栈），MemoryPool 的空闲链表这类“内存块本身就是节点”的场景可以直接用。
+    // 栈顶是“指针 + 版本号”打包成的一个 64 位字：每次修改栈顶版本号加一，
+    // 即使某个节点被弹出又压回（栈顶指针回到原值，即 ABA），过期的 CAS 也会因为版本号不同而失败。
+    //   - 64 位平台：指针占 48 位（用户态地址空间），版本号用掉高 16 位和指针按 8 字节对齐空出的低 3 位，共 19 位；
+    //     32 位平台：版本号占高 32 位和低 2 位；
+    //   - 版本号会回绕：出栈线程在读栈顶与 CAS 之间被抢占时，只要别的线程恰好做了 2^19 的整数倍次修改，
+    //     过期的 CAS 仍会成功。热点空闲链表上 6.5 万次修改只要约 1 ms，16 位版本号在一次调度延迟内就可能回绕，
+    //     19 位把窗口放大到约 50 万次；要彻底排除需要双字 CAS（cmpxchg16b），这里为了可移植没有使用；
+    //   - 平台限制：64 位上要求节点地址落在低 48 位。x86-64 四级页表、AArch64 48 位虚拟地址下用户态地址都满足；
+    //     x86-64 五级页表（LA57）的 Linux 也只在 mmap 显式给出高地址提示时才会分配 47 位以上的地址。
+    //     打包时检查地址，不满足直接 abort（NDEBUG 下同样检查），不会静默把高位覆盖成版本号；
+    //   - 出栈会读取栈顶节点的 next，所以节点内存在栈的整个生命周期内必须保持可读（内存池的槽、对象池里的对象），
+    //     节点弹出后可以任意改写和复用，但不能归还给操作系统。
+    class LinkStack{
+    public:
+        using Link = AtomicSinglyLink;
+
+        LinkStack()=default;
+        LinkStack(const LinkStack&)=delete;
+        LinkStack& operator=(const LinkStack&)=delete;
+
+        void push(Link* link){
+            push_chain(link,link);
+        }
+
+        // 一次压入 first -> ... -> last 这条已经用 next 串好的链
+        void push_chain(Link* first, Link* last){
+            Word old=_top.load(std::memory_order_relaxed);
+            do{
+                last->next.store(pointer(old),std::memory_order_relaxed);
+            }while(!_top.compare_exchange_weak(old,pack(first,tag(old)+1),std::memory_order_release,std::memory_order_relaxed));
+        }
+
+        // 栈空时返回 nullptr
+        Link* pop(){
+            Word old=_top.load(std::memory_order_acquire);
+            while(pointer(old)!=nullptr){
+                Link* next=pointer(old)->next.load(std::memory_order_relaxed);
+                if(_top.compare_exchange_weak(old,pack(next,tag(old)+1),std::memory_order_acquire,std::memory_order_acquire))
+                    return pointer(old);
+            }
+            return nullptr;
+        }
+
+        // 一次取走整个栈，返回以 nullptr 结尾的链（后压入的在前）
+        Link* pop_all(){
+            Word old=_top.load(std::memory_order_relaxed);
+            while(pointer(old)!=nullptr){
+                if(_top.compare_exchange_weak(old,pack(nullptr,tag(old)+1),std::memory_order_acquire,std::memory_order_relaxed))
+                    return pointer(old);
+            }
+            return nullptr;
+        }
+
+        // 只是某一时刻的快照
+        bool empty() const{
+            return pointer(_top.load(std::memory_order_relaxed))==nullptr;
+        }
+
+    private:
+        using Word = uint64_t;
+        static_assert(sizeof(void*)==8 || sizeof(void*)==4, "LinkStack packs 32- or 64-bit pointers");
+
+        static constexpr unsigned int kPointerBits = sizeof(void*)==8 ? 48 : 32;
+        // Link 按 alignof 对齐，地址最低的这几位恒为 0，拿来存版本号的低位
+        static constexpr unsigned int kAlignBits = alignof(Link)>=8 ? 3 : alignof(Link)>=4 ? 2 : 0;
+        static constexpr Word kAlignMask = (Word(1)<<kAlignBits)-1;
+        static constexpr Word kAddressMask = ((Word(1)<<kPointerBits)-1)&~kAlignMask;
+
+        static Word pack(Link* link, Word tag){
+            Word addr=Word(reinterpret_cast<uintptr_t>(link));
+            if((addr&~kAddressMask)!=0) // 地址超出 48 位或未对齐，无法与版本号打包
+                std::abort();
+            return ((tag>>kAlignBits)<<kPointerBits)|addr|(tag&kAlignMask);
+        }
+
+        static Link* pointer(Word word){
+            return reinterpret_cast<Link*>(uintptr_t(word&kAddressMask));
+        }
+
+        static Word tag(Word word){
+            return ((word>>kPointerBits)<<kAlignBits)|(word&kAlignMask);
+        }
+
+        std::atomic<Word> _top{0};
+    };
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef NODE_SLAB_HPP_D2DS
+#define NODE_SLAB_HPP_D2DS
+
+#include "common/common.hpp"
+
+namespace d2ds {
+
+// 容器自有的节点 slab：节点从容器自己持有的大块内存中连续切出，释放的节点挂在本地空闲链表上复用。
+//   - 切分是指针递增，空闲链表是普通单链表，都没有锁和原子操作（slab 只属于一个容器）；
+//   - 相邻申请的节点在内存中相邻，顺序遍历对缓存和预取更友好；
+//   - release_all() 直接归还所有大块，不需要逐个节点释放。
+// 块的节点数从 NodesPerBlock 开始按 2 倍增长，最多 kMaxNodesPerBlock 个。
+template<size_t NodeSize, size_t NodeAlign, typename BlockAllocator = DefaultAllocator,
+         unsigned int NodesPerBlock = 64>
+class NodeSlab {
+    static_assert(NodeSize >= sizeof(void*), "slab nodes must be able to hold a free-list pointer");
+    static_assert(NodesPerBlock > 0, "NodesPerBlock must be positive");
+    static_assert(NodeAlign <= alignof(std::max_align_t), "block allocators only guarantee max_align_t alignment");
+
+public:
+    static constexpr unsigned int kMaxNodesPerBlock = 4096;
+
+    NodeSlab() = default;
+    NodeSlab(const NodeSlab&) = delete;
+    NodeSlab& operator=(const NodeSlab&) = delete;
+
+    NodeSlab(NodeSlab&& other) { take(other); }
+
+    NodeSlab& operator=(NodeSlab&& dsObj) {
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        release_all();
+        take(dsObj);
+        return *this;
+    }
+
+    ~NodeSlab() { release_all(); }
+
+    void* allocate() {
+        if (_free != nullptr) {
+            FreeNode* node = _free;
+            _free = node->next;
+            return node;
+        }
+        if (_cursor == _limit)
+            new_block();
+        void* node = _cursor;
+        _cursor += kSlotSize;
+        return node;
+    }
+
+    void deallocate(void* addr) {
+        FreeNode* node = static_cast<FreeNode*>(addr);
+        node->next = _free;
+        _free = node;
+    }
+
+    // 归还全部大块；调用前节点中的对象需已析构（或为平凡析构）
+    void release_all() {
+        while (_blocks != nullptr) {
+            Block* next = _blocks->next;
+            BlockAllocator::deallocate(_blocks, _blocks->bytes);
+            _blocks = next;
+        }
+        _free = nullptr;
+        _cursor = _limit = nullptr;
+        _next_nodes = NodesPerBlock;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct Block {
+        Block* next;
+        size_t bytes;
+    };
+
+    static constexpr size_t kAlign = NodeAlign > alignof(Block) ? NodeAlign : alignof(Block);
+    static constexpr size_t kSlotSize = (NodeSize + NodeAlign - 1) / NodeAlign * NodeAlign;
+    static constexpr size_t kHeaderSize = (sizeof(Block) + kAlign - 1) / kAlign * kAlign;
+
+    void new_block() {
+        size_t bytes = kHeaderSize + kSlotSize * _next_nodes;
+        Block* block = static_cast<Block*>(BlockAllocator::allocate(bytes));
+        if (block == nullptr) throw std::bad_alloc();
+        block->next = _blocks;
+        block->bytes = bytes;
+        _blocks = block;
+        _cursor = reinterpret_cast<unsigned char*>(block) + kHeaderSize;
+        _limit = reinterpret_cast<unsigned char*>(block) + bytes;
+        if (_next_nodes < kMaxNodesPerBlock)
+            _next_nodes *= 2;
+    }
+
+    void take(NodeSlab& other) {
+        _blocks = other._blocks;
+        _free = other._free;
+        _cursor = other._cursor;
+        _limit = other._limit;
+        _next_nodes = other._next_nodes;
+        other._blocks = nullptr;
+        other._free = nullptr;
+        other._cursor = other._limit = nullptr;
+        other._next_nodes = NodesPerBlock;
+    }
+
+    Block* _blocks = nullptr;
+    FreeNode* _free = nullptr;
+    unsigned char* _cursor = nullptr;
+    unsigned char* _limit = nullptr;
+    unsigned int _next_nodes = NodesPerBlock;
+};
+
+// 作为链表的 Allocator 参数时启用链表自有的 slab（见 NodeSlab），例如 SLinkedList<int, Slab<>>；
+// BlockAllocator 用来申请大块内存
+template<typename BlockAllocator = DefaultAllocator, unsigned int NodesPerBlock = 64>
+struct Slab {
+    template<typename Node>
+    using Store = NodeSlab<sizeof(Node), alignof(Node), BlockAllocator, NodesPerBlock>;
+};
+
+template<typename A>
+struct is_slab : std::false_type {};
+
+template<typename BlockAllocator, unsigned int NodesPerBlock>
+struct is_slab<Slab<BlockAllocator, NodesPerBlock>> : std::true_type {};
+
+} // namespace d2ds
+
+#endif
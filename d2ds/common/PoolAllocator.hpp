@@ -0,0 +1,116 @@
+#ifndef POOL_ALLOCATOR_HPP_D2DS
+#define POOL_ALLOCATOR_HPP_D2DS
+
+#include "common/common.hpp"
+#include "common/LinkStack.hpp"
+// 需要同时编译 MemoryPool/v1/step3/src/MemoryPool.cpp
+#include "../../MemoryPool/v1/step3/include/MemoryPool.h"
+
+namespace d2ds {
+
+// 把 d2ds 的分配器接口接到 Kama_memoryPool::HashBucket 上：
+//   - <= MAX_SLOT_SIZE (512B) 的请求按 8 字节规格分类，新块从对应的 MemoryPool 切出；
+//   - 更大的请求由 HashBucket 自己转交 operator new/delete。
+// 适合链表节点这类“大小固定、频繁申请释放”的小对象；池中的槽只保证 8 字节对齐。
+//
+// 释放的小块分两层回收，都不经过 HashBucket 自己的空闲链表：
+//   - 线程本地缓存：释放的块先挂在本线程对应规格的链表上，申请时优先从这里取，热路径上没有原子操作；
+//   - 全局空闲栈：本地缓存满 kLocalCacheLimit 个时把一半整条压进该规格的 LinkStack，本地缓存为空时从这里取，
+//     线程退出时本地缓存也整条还到这里。
+// HashBucket 的 MemoryPool::popFreeList 是不带版本号的指针 CAS：生产者/消费者模式下一端不断溢出、
+// 另一端不断取用，两端同时操作全局链表，ABA 会把同一个槽同时交给两个调用者。LinkStack 的栈顶带版本号，
+// 且槽所在的 Block 直到程序退出才释放，满足 LinkStack “节点内存始终可读”的要求。
+// 因此小块一旦切出就只在 PoolAllocator 内部流转，不再还给 HashBucket；HashBucket 的空闲链表始终为空，
+// useMemory 对它的 pop 只会读到空栈。多线程下不要对同一规格混用 HashBucket::freeMemory / deleteElement。
+// 与所有建立在可复用内存上的 Treiber 栈一样，过期的出栈线程可能读到已被别人取走、正在改写的块的 next，
+// 读到的值会随 CAS 失败被丢弃；ThreadSanitizer 会把这次读报告为数据竞争。
+//
+// 第一次 allocate 时会调用 HashBucket::initMemoryPool()，之后不要再手动 init，
+// 否则已发出去的块所在的 Block 会被各池“遗忘”。
+struct PoolAllocator {
+    static void* allocate(size_t bytes) {
+        if (bytes == 0 || bytes > MAX_SLOT_SIZE)
+            return Kama_memoryPool::HashBucket::useMemory(bytes);
+
+        LocalCache& cache = local_cache();
+        size_t index = size_class(bytes);
+        Link* block = cache.heads[index];
+        if (block != nullptr) {
+            cache.heads[index] = block->next.load(std::memory_order_relaxed);
+            cache.counts[index]--;
+            return block;
+        }
+        if (Link* shared = shared_stack(index).pop())
+            return shared;
+        return Kama_memoryPool::HashBucket::useMemory(bytes);
+    }
+
+    static void deallocate(void* addr, size_t bytes) {
+        if (addr == nullptr) return;
+        if (bytes > MAX_SLOT_SIZE) {
+            Kama_memoryPool::HashBucket::freeMemory(addr, bytes);
+            return;
+        }
+
+        LocalCache& cache = local_cache();
+        size_t index = size_class(bytes);
+        if (cache.counts[index] >= kLocalCacheLimit)
+            cache.spill(index, kLocalCacheLimit / 2);
+        Link* block = new (addr) Link;
+        block->next.store(cache.heads[index], std::memory_order_relaxed);
+        cache.heads[index] = block;
+        cache.counts[index]++;
+    }
+
+private:
+    using Link = AtomicSinglyLink;
+
+    static constexpr unsigned int kLocalCacheLimit = 1024;
+
+    struct LocalCache {
+        Link* heads[MEMORY_POOL_NUM] = {};
+        unsigned int counts[MEMORY_POOL_NUM] = {};
+
+        LocalCache() {
+            // HashBucket 的各规格池必须先 init 才能用，这里保证只初始化一次（C++11 起线程安全）
+            static const bool inited = (Kama_memoryPool::HashBucket::initMemoryPool(), true);
+            (void)inited;
+        }
+
+        ~LocalCache() {
+            for (size_t i = 0; i < MEMORY_POOL_NUM; ++i)
+                spill(i, counts[i]);
+        }
+
+        // 把本地链表最前面的 n 个块整条压进全局空闲栈
+        void spill(size_t index, unsigned int n) {
+            if (n == 0) return;
+            Link* first = heads[index];
+            Link* last = first;
+            for (unsigned int k = 1; k < n; ++k)
+                last = last->next.load(std::memory_order_relaxed);
+            heads[index] = last->next.load(std::memory_order_relaxed);
+            counts[index] -= n;
+            shared_stack(index).push_chain(first, last);
+        }
+    };
+
+    // 与 HashBucket 相同的映射：1-8 字节 -> 0, 9-16 字节 -> 1 ...
+    static size_t size_class(size_t bytes) {
+        return (bytes + SLOT_BASE_SIZE - 1) / SLOT_BASE_SIZE - 1;
+    }
+
+    static LocalCache& local_cache() {
+        thread_local LocalCache cache;
+        return cache;
+    }
+
+    static LinkStack& shared_stack(size_t index) {
+        static LinkStack stacks[MEMORY_POOL_NUM];
+        return stacks[index];
+    }
+};
+
+} // namespace d2ds
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef COMMON_HPP_D2DS
+#define COMMON_HPP_D2DS
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace d2ds {
+
+// 拷贝/移动赋值中的自赋值检查，要求参数名为 dsObj
+#define D2DS_SELF_ASSIGNMENT_CHECKER if (this == &dsObj) return *this;
+
+#define d2ds_assert(expr) assert(expr)
+
+// constexpr 函数里区分编译期/运行期求值（C++20 的 std::is_constant_evaluated，GCC 9+/Clang 9+ 在 C++17 下也提供）：
+// 编译期走普通循环，运行期才调用 memcpy / SIMD 内核这类非 constexpr 的实现
+#if defined(__GNUC__) || defined(__clang__)
+#define D2DS_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define D2DS_IS_CONSTANT_EVALUATED() false
+#endif
+
+// 缓存行大小，用于 alignas 避免伪共享、让定长数组按整行对齐
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// 所有 d2ds 容器的分配器接口：两个静态函数，释放时需要带回申请时的字节数
+//   static void* allocate(size_t bytes);
+//   static void deallocate(void* addr, size_t bytes);
+//
+// 可选扩展：
+//   static void* reallocate(void* addr, size_t old_bytes, size_t new_bytes);
+// 语义同 realloc：能原地扩容就原地扩，否则搬到新地址（按字节拷贝）并释放旧块，失败返回 nullptr。
+// 只有“可平凡搬迁”的元素类型才会走这条路径，见 is_trivially_relocatable。
+struct DefaultAllocator {
+    static void* allocate(size_t bytes) {
+        return std::malloc(bytes);
+    }
+
+    static void deallocate(void* addr, size_t bytes) {
+        (void)bytes;
+        std::free(addr);
+    }
+
+    static void* reallocate(void* addr, size_t old_bytes, size_t new_bytes) {
+        (void)old_bytes;
+        return std::realloc(addr, new_bytes);
+    }
+};
+
+// 在只保证 max_align_t 对齐的分配器上申请 align 对齐（2 的幂）的内存：
+// 多申请 align + 一个指针的空间，把原始地址记在返回地址之前，释放时取回
+template<typename Allocator>
+void* aligned_allocate(size_t bytes, size_t align) {
+    void* raw = Allocator::allocate(bytes + align + sizeof(void*));
+    if (raw == nullptr) throw std::bad_alloc();
+    uintptr_t addr = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + align - 1) & ~uintptr_t(align - 1);
+    reinterpret_cast<void**>(addr)[-1] = raw;
+    return reinterpret_cast<void*>(addr);
+}
+
+template<typename Allocator>
+void aligned_deallocate(void* addr, size_t bytes, size_t align) {
+    if (addr == nullptr) return;
+    Allocator::deallocate(static_cast<void**>(addr)[-1], bytes + align + sizeof(void*));
+}
+
+// 检测分配器是否提供 reallocate
+template<typename Allocator, typename = void>
+struct has_reallocate : std::false_type {};
+
+template<typename Allocator>
+struct has_reallocate<Allocator, decltype((void)Allocator::reallocate(nullptr, size_t(0), size_t(0)))>
+    : std::true_type {};
+
+// “可平凡搬迁”：把对象按字节 memcpy 到新地址、且不再对旧地址调用析构，等价于移动+析构。
+// 默认只认可平凡拷贝的类型；不含自引用指针的类型（如持有堆指针的句柄类）可以特化为 true_type。
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// 把 from 上的 n 个元素搬到未初始化的 to 上，结束后 from 上不再有存活对象：
+// 可平凡搬迁的类型一次 memcpy，其他类型 move_if_noexcept 逐个搬迁。
+// 若拷贝构造抛异常，已构造的元素会被析构，源数据保持完整（强异常安全）
+template<typename T>
+void relocate(T* from, unsigned int n, T* to) {
+    if (n == 0) return;
+    if constexpr (is_trivially_relocatable<T>::value) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(T) * n);
+    } else {
+        unsigned int i = 0;
+        try {
+            for (; i < n; i++)
+                new (to + i) T(std::move_if_noexcept(from[i]));
+        } catch (...) {
+            while (i > 0) (to + (--i))->~T();
+            throw;
+        }
+        for (i = 0; i < n; i++)
+            (from + i)->~T();
+    }
+}
+
+} // namespace d2ds
+
+#endif
@@ -0,0 +1,359 @@
+#ifndef SIMD_HPP_D2DS
+#define SIMD_HPP_D2DS
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// 数值数组的批量运算内核：add / sub / mul / fma / dot / sum / min / max / equal。
+//
+// 实现方式：每个内核只写一份模板，向量宽度 B 作为模板参数（0 表示标量），
+// 用 GCC/Clang 的向量扩展 (vector_size) 表达 B 字节宽的 SIMD 寄存器；
+// 再用 __attribute__((target("..."))) 包一层，让同一份代码分别以 SSE2 (B=16)
+// 和 AVX2+FMA (B=32) 指令集编译，运行时按 CPU 支持情况选择（结果缓存，只检测一次）。
+// 非 x86 平台（如 Apple Silicon）只保留标量版本，由编译器自动向量化为 NEON。
+//
+// 注意：浮点的 sum/dot 在 SIMD 路径下是分组累加，舍入误差与顺序累加不同；
+// fma 在支持的平台上会被编译成融合乘加指令。
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define D2DS_SIMD_X86 1
+#endif
+
+namespace d2ds {
+namespace simd {
+
+enum class Isa { Scalar, SSE2, AVX2 };
+
+inline Isa cpu_isa() {
+#ifdef D2DS_SIMD_X86
+    static const Isa isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Isa::AVX2;
+        if (__builtin_cpu_supports("sse2")) return Isa::SSE2;
+        return Isa::Scalar;
+    }();
+    return isa;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+inline const char* isa_name(Isa isa) {
+    switch (isa) {
+    case Isa::AVX2: return "AVX2";
+    case Isa::SSE2: return "SSE2";
+    default: return "Scalar";
+    }
+}
+
+// 可以走 SIMD 内核的元素类型：除 bool 以外的算术类型
+template<typename T>
+struct is_vectorizable
+    : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+namespace detail {
+
+// 内核辅助函数必须内联进带 target 属性的外层函数，才能按对应指令集生成代码
+#define D2DS_SIMD_INLINE inline __attribute__((always_inline))
+
+// 向量值一律通过引用传递：宽向量按值传参/返回会触发 GCC 的 -Wpsabi 提示（未启用 AVX 时 ABI 不同）
+template<typename T, size_t B>
+struct Lanes {
+    typedef T V __attribute__((vector_size(B)));
+    static constexpr size_t N = B / sizeof(T);
+
+    static D2DS_SIMD_INLINE void load(V& v, const T* p) {
+        std::memcpy(&v, p, sizeof(V)); // 非对齐加载
+    }
+    static D2DS_SIMD_INLINE void store(T* p, const V& v) {
+        std::memcpy(p, &v, sizeof(V));
+    }
+};
+
+// a = a op b
+struct AddOp { template<typename X> static D2DS_SIMD_INLINE void apply(X& a, const X& b) { a = a + b; } };
+struct SubOp { template<typename X> static D2DS_SIMD_INLINE void apply(X& a, const X& b) { a = a - b; } };
+struct MulOp { template<typename X> static D2DS_SIMD_INLINE void apply(X& a, const X& b) { a = a * b; } };
+
+// out[i] = Op(a[i], b[i])
+template<typename Op>
+struct Elementwise {
+    template<size_t B, typename T>
+    static D2DS_SIMD_INLINE void run(const T* a, const T* b, T* out, size_t n) {
+        size_t i = 0;
+        if constexpr (B != 0) {
+            using L = Lanes<T, B>;
+            typename L::V x, y;
+            for (; i + L::N <= n; i += L::N) {
+                L::load(x, a + i);
+                L::load(y, b + i);
+                Op::apply(x, y);
+                L::store(out + i, x);
+            }
+        }
+        for (; i < n; ++i) {
+            T x = a[i];
+            Op::apply(x, b[i]);
+            out[i] = x;
+        }
+    }
+};
+
+// out[i] = a[i] * b[i] + c[i]
+struct Fma {
+    template<size_t B, typename T>
+    static D2DS_SIMD_INLINE void run(const T* a, const T* b, const T* c, T* out, size_t n) {
+        size_t i = 0;
+        if constexpr (B != 0) {
+            using L = Lanes<T, B>;
+            typename L::V x, y, z;
+            for (; i + L::N <= n; i += L::N) {
+                L::load(x, a + i);
+                L::load(y, b + i);
+                L::load(z, c + i);
+                x = x * y + z;
+                L::store(out + i, x);
+            }
+        }
+        for (; i < n; ++i)
+            out[i] = a[i] * b[i] + c[i];
+    }
+};
+
+// 归约：两个累加器交替使用，隐藏加法延迟
+struct Dot {
+    template<size_t B, typename T>
+    static D2DS_SIMD_INLINE T run(const T* a, const T* b, size_t n) {
+        T r = T();
+        size_t i = 0;
+        if constexpr (B != 0) {
+            using L = Lanes<T, B>;
+            typename L::V acc0 = {}, acc1 = {}, x0, y0, x1, y1;
+            for (; i + 2 * L::N <= n; i += 2 * L::N) {
+                L::load(x0, a + i);
+                L::load(y0, b + i);
+                L::load(x1, a + i + L::N);
+                L::load(y1, b + i + L::N);
+                acc0 += x0 * y0;
+                acc1 += x1 * y1;
+            }
+            acc0 += acc1;
+            for (size_t k = 0; k < L::N; ++k) r += acc0[k];
+        }
+        for (; i < n; ++i)
+            r += a[i] * b[i];
+        return r;
+    }
+};
+
+struct Sum {
+    template<size_t B, typename T>
+    static D2DS_SIMD_INLINE T run(const T* a, size_t n) {
+        T r = T();
+        size_t i = 0;
+        if constexpr (B != 0) {
+            using L = Lanes<T, B>;
+            typename L::V acc0 = {}, acc1 = {}, x0, x1;
+            for (; i + 2 * L::N <= n; i += 2 * L::N) {
+                L::load(x0, a + i);
+                L::load(x1, a + i + L::N);
+                acc0 += x0;
+                acc1 += x1;
+            }
+            acc0 += acc1;
+            for (size_t k = 0; k < L::N; ++k) r += acc0[k];
+        }
+        for (; i < n; ++i)
+            r += a[i];
+        return r;
+    }
+};
+
+// 要求 n > 0
+template<bool IsMin>
+struct MinMax {
+    template<typename X>
+    static D2DS_SIMD_INLINE X pick(X a, X b) { return IsMin ? (b < a ? b : a) : (a < b ? b : a); }
+
+    template<size_t B, typename T>
+    static D2DS_SIMD_INLINE T run(const T* a, size_t n) {
+        T r = a[0];
+        size_t i = 0;
+        if constexpr (B != 0) {
+            using L = Lanes<T, B>;
+            if (n >= L::N) {
+                typename L::V acc, x;
+                L::load(acc, a);
+                for (i = L::N; i + L::N <= n; i += L::N) {
+                    L::load(x, a + i);
+                    acc = IsMin ? (x < acc ? x : acc) : (acc < x ? x : acc);
+                }
+                for (size_t k = 0; k < L::N; ++k) r = pick(r, T(acc[k]));
+            }
+        }
+        for (; i < n; ++i)
+            r = pick(r, a[i]);
+        return r;
+    }
+};
+
+// 逐元素 ==（浮点按值比较：NaN 不等于自身，+0 等于 -0）；每 64 组检查一次以便提前退出
+struct Equal {
+    template<size_t B, typename T>
+    static D2DS_SIMD_INLINE bool run(const T* a, const T* b, size_t n) {
+        size_t i = 0;
+        if constexpr (B != 0) {
+            using L = Lanes<T, B>;
+            typename L::V x, y;
+            while (i + L::N <= n) {
+                decltype(x != y) diff = {};
+                for (size_t k = 0; k < 64 && i + L::N <= n; ++k, i += L::N) {
+                    L::load(x, a + i);
+                    L::load(y, b + i);
+                    diff |= x != y;
+                }
+                for (size_t k = 0; k < L::N; ++k)
+                    if (diff[k]) return false;
+            }
+        }
+        for (; i < n; ++i)
+            if (!(a[i] == b[i])) return false;
+        return true;
+    }
+};
+
+#ifdef D2DS_SIMD_X86
+template<typename Kernel, typename... Args>
+__attribute__((target("avx2,fma"))) auto run_avx2(Args... args) {
+    return Kernel::template run<32>(args...);
+}
+
+template<typename Kernel, typename... Args>
+__attribute__((target("sse2"))) auto run_sse2(Args... args) {
+    return Kernel::template run<16>(args...);
+}
+#endif
+
+template<typename Kernel, typename... Args>
+auto run_scalar(Args... args) {
+    return Kernel::template run<0>(args...);
+}
+
+template<typename Kernel, typename... Args>
+inline auto dispatch(Args... args) {
+#ifdef D2DS_SIMD_X86
+    switch (cpu_isa()) {
+    case Isa::AVX2: return run_avx2<Kernel>(args...);
+    case Isa::SSE2: return run_sse2<Kernel>(args...);
+    default: break;
+    }
+#endif
+    return run_scalar<Kernel>(args...);
+}
+
+} // namespace detail
+
+// ---- 对外接口：T 必须满足 is_vectorizable；out 可以与输入相同（原地运算）----
+
+template<typename T>
+void add(const T* a, const T* b, T* out, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    detail::dispatch<detail::Elementwise<detail::AddOp>>(a, b, out, n);
+}
+
+template<typename T>
+void sub(const T* a, const T* b, T* out, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    detail::dispatch<detail::Elementwise<detail::SubOp>>(a, b, out, n);
+}
+
+template<typename T>
+void mul(const T* a, const T* b, T* out, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    detail::dispatch<detail::Elementwise<detail::MulOp>>(a, b, out, n);
+}
+
+template<typename T>
+void fma(const T* a, const T* b, const T* c, T* out, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    detail::dispatch<detail::Fma>(a, b, c, out, n);
+}
+
+template<typename T>
+T dot(const T* a, const T* b, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    return detail::dispatch<detail::Dot>(a, b, n);
+}
+
+template<typename T>
+T sum(const T* a, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    return detail::dispatch<detail::Sum>(a, n);
+}
+
+// min / max 要求 n > 0
+template<typename T>
+T min(const T* a, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    return detail::dispatch<detail::MinMax<true>>(a, n);
+}
+
+template<typename T>
+T max(const T* a, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    return detail::dispatch<detail::MinMax<false>>(a, n);
+}
+
+template<typename T>
+bool equal(const T* a, const T* b, size_t n) {
+    static_assert(is_vectorizable<T>::value, "d2ds::simd needs an arithmetic element type");
+    return detail::dispatch<detail::Equal>(a, b, n);
+}
+
+// ---- 定长有序键数组内的无分支定位（B 树节点、静态搜索树的块）----
+
+template<typename T>
+struct has_rank : is_vectorizable<T> {};
+
+// rank 的空位填充值：不小于 T 的任何值。整数取最大值；浮点取 +inf——浮点的最大值是有限数，+inf 会把它计为 < x
+template<typename T>
+constexpr T rank_padding() {
+    if constexpr (std::is_floating_point<T>::value)
+        return std::numeric_limits<T>::infinity();
+    else
+        return std::numeric_limits<T>::max();
+}
+
+// 统计整个数组 keys[0, N) 中 < x（Inclusive 时为 <= x）的元素个数：整块按 16 字节向量比较，
+// 每个 lane 的比较结果是 0 / -1，累加后取反就是计数，没有分支。N 通常只有一两条缓存行，
+// 直接用基线指令集（SSE2 / NEON）编译，不走运行时分派。
+// 调用方把空位填充为 rank_padding<T>()：它不会被计为 < x；计为 <= x 只在 x 等于填充值时发生，需要截断到实际个数。
+// x 或键为 NaN 时结果无意义
+template<bool Inclusive, typename T, size_t N>
+inline unsigned int rank(const T (&keys)[N], T x) {
+    static_assert(has_rank<T>::value, "d2ds::simd::rank needs an arithmetic element type");
+    typedef T V __attribute__((vector_size(16)));
+    constexpr size_t kLanes = 16 / sizeof(T);
+    static_assert(N % kLanes == 0, "key array must be a whole number of vectors");
+    V xv;
+    for (size_t k = 0; k < kLanes; ++k) xv[k] = x;
+    decltype(xv < xv) acc = {};
+    for (size_t i = 0; i < N; i += kLanes) {
+        V v;
+        std::memcpy(&v, keys + i, sizeof(V));
+        if constexpr (Inclusive)
+            acc += v <= xv;
+        else
+            acc += v < xv;
+    }
+    long total = 0;
+    for (size_t k = 0; k < kLanes; ++k) total -= long(acc[k]);
+    return unsigned(total);
+}
+
+} // namespace simd
+} // namespace d2ds
+
+#endif
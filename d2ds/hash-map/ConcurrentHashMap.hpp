@@ -0,0 +1,310 @@
+#ifndef CONCURRENT_HASH_MAP_HPP_D2DS
+#define CONCURRENT_HASH_MAP_HPP_D2DS
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "common/common.hpp"
+#include "common/PoolAllocator.hpp"
+#include "hash-map/FlatHashMap.hpp"
+
+namespace d2ds {
+// show your code
+
+    template<typename K, typename V>
+    struct ConcurrentHashMapNode{
+        ConcurrentHashMapNode* next;
+        size_t hash; // 缓存哈希值：分片内扩容时不必重新计算，比较键之前先比哈希
+        K key;
+        V value;
+
+        template<typename KK, typename... Args>
+        ConcurrentHashMapNode(size_t h, KK&& k, Args&&... args)
+            : next(nullptr), hash(h), key(std::forward<KK>(k)), value(std::forward<Args>(args)...){}
+    };
+
+    // 分片并发哈希表：键空间按哈希高位分成 Shards 个分片，每个分片是一张独立的拉链哈希表，
+    // 由自己的读写锁保护：
+    //   - 查找只拿分片的共享锁，不同分片、同一分片的读者之间都不互斥；
+    //   - 写操作只锁一个分片；分片超过负载上限时在持有该分片写锁的情况下单独扩容，
+    //     其他分片照常读写，没有全局停顿；
+    //   - 节点大小固定、增删频繁，默认从 PoolAllocator（Kama_memoryPool）分配。
+    // 不提供迭代器：返回引用或迭代器会让调用者在锁外访问元素。读取用 find（拷贝出值）或 visit（在锁内回调），
+    // 读-改-写用 compute；回调在分片锁内执行，不能再访问同一个 map。
+    template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+             typename Allocator = PoolAllocator, unsigned int Shards = 64>
+    class ConcurrentHashMap{
+        static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0, "shard count must be a power of two");
+
+    public:
+        using Node = ConcurrentHashMapNode<K, V>;
+
+        static_assert(alignof(Node) <= 8, "PoolAllocator slots are only 8-byte aligned");
+
+        ConcurrentHashMap()=default;
+        ConcurrentHashMap(const ConcurrentHashMap&)=delete;
+        ConcurrentHashMap& operator=(const ConcurrentHashMap&)=delete;
+
+        ~ConcurrentHashMap(){
+            for(Shard& shard : _shards)
+                shard.destroy();
+        }
+
+        // 键不存在时插入并返回 true；已存在时覆盖旧值并返回 false
+        template<typename KK, typename M>
+        bool insert_or_assign(KK&& key, M&& value){
+            size_t hash=hash_of(key);
+            Shard& shard=shard_of(hash);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            if(Node* node=shard.find(hash,key,_eq)){
+                node->value=std::forward<M>(value);
+                return false;
+            }
+            shard.insert(new_node(hash,std::forward<KK>(key),std::forward<M>(value)));
+            return true;
+        }
+
+        // 键不存在时插入；已存在时不修改，返回 false
+        template<typename KK, typename... Args>
+        bool try_emplace(KK&& key, Args&&... args){
+            size_t hash=hash_of(key);
+            Shard& shard=shard_of(hash);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            if(shard.find(hash,key,_eq)!=nullptr)
+                return false;
+            shard.insert(new_node(hash,std::forward<KK>(key),std::forward<Args>(args)...));
+            return true;
+        }
+
+        // 值在锁内拷贝出来
+        std::optional<V> find(const K& key) const{
+            size_t hash=hash_of(key);
+            const Shard& shard=shard_of(hash);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if(const Node* node=shard.find(hash,key,_eq))
+                return node->value;
+            return std::nullopt;
+        }
+
+        bool contains(const K& key) const{
+            size_t hash=hash_of(key);
+            const Shard& shard=shard_of(hash);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            return shard.find(hash,key,_eq)!=nullptr;
+        }
+
+        // 键存在时在共享锁内调用 f(const V&)，避免拷贝大对象
+        template<typename F>
+        bool visit(const K& key, F f) const{
+            size_t hash=hash_of(key);
+            const Shard& shard=shard_of(hash);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if(const Node* node=shard.find(hash,key,_eq)){
+                f(static_cast<const V&>(node->value));
+                return true;
+            }
+            return false;
+        }
+
+        bool erase(const K& key){
+            size_t hash=hash_of(key);
+            Shard& shard=shard_of(hash);
+            Node* node;
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                node=shard.unlink(hash,key,_eq);
+            }
+            if(node==nullptr) return false;
+            free_node(node); // 析构和释放放在锁外
+            return true;
+        }
+
+        // 原子的读-改-写：在分片写锁内调用 f(std::optional<V>& value)，
+        // 进入时 value 为当前值（键不存在时为空）；返回后 value 有值则写回，为空则删除该键。
+        // 返回操作后键是否存在
+        template<typename F>
+        bool compute(const K& key, F f){
+            size_t hash=hash_of(key);
+            Shard& shard=shard_of(hash);
+            Node* removed=nullptr;
+            bool present;
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                Node* node=shard.find(hash,key,_eq);
+                std::optional<V> value;
+                if(node!=nullptr) value.emplace(std::move(node->value));
+                try{
+                    f(value);
+                }catch(...){
+                    if(node!=nullptr && value.has_value()) node->value=std::move(*value);
+                    throw;
+                }
+                present=value.has_value();
+                if(node!=nullptr){
+                    if(present) node->value=std::move(*value);
+                    else removed=shard.unlink(hash,key,_eq);
+                }else if(present){
+                    shard.insert(new_node(hash,key,std::move(*value)));
+                }
+            }
+            if(removed!=nullptr) free_node(removed);
+            return present;
+        }
+
+        // 逐个分片在共享锁内调用 f(const K&, const V&)；不同分片之间不是同一时刻的快照
+        template<typename F>
+        void for_each(F f) const{
+            for(const Shard& shard : _shards){
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                for(size_t b=0;b<shard.bucket_count;b++)
+                    for(const Node* node=shard.buckets[b];node!=nullptr;node=node->next)
+                        f(static_cast<const K&>(node->key),static_cast<const V&>(node->value));
+            }
+        }
+
+        // 各分片计数之和，并发修改时只是近似值
+        size_t size() const{
+            size_t n=0;
+            for(const Shard& shard : _shards)
+                n+=shard.size.load(std::memory_order_relaxed);
+            return n;
+        }
+
+        bool empty() const{
+            return size()==0;
+        }
+
+        void clear(){
+            for(Shard& shard : _shards){
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                shard.destroy();
+            }
+        }
+
+    private:
+        static constexpr size_t kInitialBuckets = 16;
+
+        struct alignas(CACHE_LINE_SIZE) Shard{
+            mutable std::shared_mutex mutex;
+            Node** buckets=nullptr;
+            size_t bucket_count=0;
+            std::atomic<size_t> size{0}; // 只在写锁内修改，size() 无锁读取
+
+            template<typename Eq>
+            Node* find(size_t hash, const K& key, const Eq& eq) const{
+                if(bucket_count==0) return nullptr;
+                for(Node* node=buckets[bucket_index(hash)];node!=nullptr;node=node->next)
+                    if(node->hash==hash && eq(node->key,key))
+                        return node;
+                return nullptr;
+            }
+
+            void insert(Node* node){
+                size_t n=size.load(std::memory_order_relaxed)+1;
+                if(n>bucket_count) // 负载因子上限 1
+                    rehash(bucket_count==0 ? kInitialBuckets : bucket_count*2);
+                Node*& head=buckets[bucket_index(node->hash)];
+                node->next=head;
+                head=node;
+                size.store(n,std::memory_order_relaxed);
+            }
+
+            template<typename Eq>
+            Node* unlink(size_t hash, const K& key, const Eq& eq){
+                if(bucket_count==0) return nullptr;
+                for(Node** link=&buckets[bucket_index(hash)];*link!=nullptr;link=&(*link)->next){
+                    Node* node=*link;
+                    if(node->hash==hash && eq(node->key,key)){
+                        *link=node->next;
+                        size.store(size.load(std::memory_order_relaxed)-1,std::memory_order_relaxed);
+                        return node;
+                    }
+                }
+                return nullptr;
+            }
+
+            // 分片的桶下标用哈希低位，分片号用高位，两者互不相关
+            size_t bucket_index(size_t hash) const{
+                return hash&(bucket_count-1);
+            }
+
+            void rehash(size_t new_count){
+                Node** fresh=static_cast<Node**>(Allocator::allocate(sizeof(Node*)*new_count));
+                if(fresh==nullptr) throw std::bad_alloc();
+                for(size_t b=0;b<new_count;b++) fresh[b]=nullptr;
+                for(size_t b=0;b<bucket_count;b++){
+                    for(Node* node=buckets[b];node!=nullptr;){
+                        Node* next=node->next;
+                        Node*& head=fresh[node->hash&(new_count-1)];
+                        node->next=head;
+                        head=node;
+                        node=next;
+                    }
+                }
+                if(buckets!=nullptr)
+                    Allocator::deallocate(buckets,sizeof(Node*)*bucket_count);
+                buckets=fresh;
+                bucket_count=new_count;
+            }
+
+            void destroy(){
+                for(size_t b=0;b<bucket_count;b++){
+                    for(Node* node=buckets[b];node!=nullptr;){
+                        Node* next=node->next;
+                        free_node(node);
+                        node=next;
+                    }
+                }
+                if(buckets!=nullptr)
+                    Allocator::deallocate(buckets,sizeof(Node*)*bucket_count);
+                buckets=nullptr;
+                bucket_count=0;
+                size.store(0,std::memory_order_relaxed);
+            }
+        };
+
+        size_t hash_of(const K& key) const{
+            return size_t(detail::mix_hash(uint64_t(_hash(key))));
+        }
+
+        Shard& shard_of(size_t hash){
+            return _shards[(hash>>(sizeof(size_t)*8-kShardBits))&(Shards-1)];
+        }
+
+        const Shard& shard_of(size_t hash) const{
+            return _shards[(hash>>(sizeof(size_t)*8-kShardBits))&(Shards-1)];
+        }
+
+        template<typename KK, typename... Args>
+        static Node* new_node(size_t hash, KK&& key, Args&&... args){
+            void* p=Allocator::allocate(sizeof(Node));
+            if(p==nullptr) throw std::bad_alloc();
+            try{
+                return new (p) Node(hash,std::forward<KK>(key),std::forward<Args>(args)...);
+            }catch(...){
+                Allocator::deallocate(p,sizeof(Node));
+                throw;
+            }
+        }
+
+        static void free_node(Node* node){
+            node->~Node();
+            Allocator::deallocate(node,sizeof(Node));
+        }
+
+        static constexpr unsigned int log2(unsigned int n){
+            return n<=1 ? 0 : 1+log2(n/2);
+        }
+
+        static constexpr unsigned int kShardBits = log2(Shards) == 0 ? 1 : log2(Shards);
+
+        Shard _shards[Shards];
+        Hash _hash;
+        KeyEqual _eq;
+    };
+}
+
+#endif
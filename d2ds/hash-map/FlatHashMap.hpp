@@ -0,0 +1,445 @@
+#ifndef FLAT_HASH_MAP_HPP_D2DS
+#define FLAT_HASH_MAP_HPP_D2DS
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/common.hpp"
+
+namespace d2ds {
+// show your code
+
+namespace detail {
+
+    // 控制字节：满槽存放哈希值的低 7 位 (h2, 0..127)，其余状态都是负数，
+    // 因此“是否空闲”就是符号位，SSE2 用一条 movemask 就能取出 16 个槽的状态
+    using ctrl_t = signed char;
+    constexpr ctrl_t kEmpty = -128;   // 0b10000000
+    constexpr ctrl_t kDeleted = -2;   // 0b11111110，墓碑
+    constexpr ctrl_t kSentinel = -1;  // 0b11111111，控制字节数组末尾，迭代器遇到它停下
+
+    inline bool is_full(ctrl_t c) { return c >= 0; }
+
+    // 一组 16 个控制字节；probe 时按组读取，一次比较出组内所有候选槽，
+    // 返回的掩码第 i 位对应组内第 i 个槽
+    struct CtrlGroup {
+        static constexpr size_t kWidth = 16;
+
+#if defined(__SSE2__)
+        explicit CtrlGroup(const ctrl_t* p) : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        uint32_t match(ctrl_t h2) const {
+            return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+        }
+
+        uint32_t match_empty_or_deleted() const {
+            return uint32_t(_mm_movemask_epi8(_ctrl));
+        }
+
+    private:
+        __m128i _ctrl;
+#else
+        // 非 x86 平台逐字节比较，编译器一般会自动向量化
+        explicit CtrlGroup(const ctrl_t* p) { std::memcpy(_ctrl, p, kWidth); }
+
+        uint32_t match(ctrl_t h2) const {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < kWidth; ++i)
+                mask |= uint32_t(_ctrl[i] == h2) << i;
+            return mask;
+        }
+
+        uint32_t match_empty_or_deleted() const {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < kWidth; ++i)
+                mask |= uint32_t(_ctrl[i] < 0) << i;
+            return mask;
+        }
+
+    private:
+        ctrl_t _ctrl[kWidth];
+#endif
+
+    public:
+        uint32_t match_empty() const { return match(kEmpty); }
+        uint32_t match_full() const { return ~match_empty_or_deleted() & 0xFFFFu; }
+    };
+
+    // 容量为 0 时 ctrl 指向这里，查找不用额外判空：整组都是 kEmpty，第一组就会停下
+    alignas(16) inline const ctrl_t kEmptyGroup[CtrlGroup::kWidth + 1] = {
+        kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+        kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kSentinel};
+
+    // std::hash 对整数通常是恒等映射，而 h1 取高位、h2 取低 7 位，必须先把各位充分混合
+    inline uint64_t mix_hash(uint64_t h) {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t m = __uint128_t(h) * 0x9E3779B97F4A7C15ull;
+        return uint64_t(m) ^ uint64_t(m >> 64);
+#else
+        h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+        return h ^ (h >> 33);
+#endif
+    }
+
+} // namespace detail
+
+// 开放寻址哈希表（Swiss table 风格）：
+//   - 元素直接存放在槽数组里，控制字节单独一个数组，一次申请（Allocator）两块连续存放；
+//   - 哈希值高位 (h1) 决定从哪一组开始探测，低 7 位 (h2) 存入控制字节；
+//     查找时一次比较 16 个控制字节，只有 h2 相同的槽才去比较键，遇到含空槽的组即可判定不存在；
+//   - 组按 16 字节对齐划分，组间按三角数序列 (1, 2, 3, ...) 跳跃，组数是 2 的幂，保证遍历所有组；
+//   - 删除时若所在组里还有空槽，说明没有任何查找会越过这一组，直接标记为空；否则才留下墓碑；
+//   - 负载因子上限 7/8；插入时空位用完就扩容，若大部分空位被墓碑占着，则按原容量重建以清理墓碑。
+// 扩容/重建会移动元素，迭代器和元素引用随之失效；元素类型需要 alignof <= max_align_t。
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+         typename Allocator = DefaultAllocator>
+class FlatHashMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+    static_assert(alignof(value_type) <= alignof(std::max_align_t), "slot type is over-aligned");
+
+    template<bool Const>
+    class IteratorBase {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const value_type*, value_type*>::type;
+        using reference = typename std::conditional<Const, const value_type&, value_type&>::type;
+
+        IteratorBase() : _ctrl(nullptr), _slot(nullptr) {}
+        // iterator 可以隐式转换为 const_iterator
+        template<bool C = Const, typename = typename std::enable_if<C>::type>
+        IteratorBase(const IteratorBase<false>& it) : _ctrl(it._ctrl), _slot(it._slot) {}
+
+        reference operator*() const { return *_slot; }
+        pointer operator->() const { return _slot; }
+
+        IteratorBase& operator++() {
+            ++_ctrl;
+            ++_slot;
+            skip_free();
+            return *this;
+        }
+
+        IteratorBase operator++(int) {
+            IteratorBase old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const IteratorBase& it) const { return _ctrl == it._ctrl; }
+        bool operator!=(const IteratorBase& it) const { return _ctrl != it._ctrl; }
+
+    private:
+        friend class FlatHashMap;
+        template<bool> friend class IteratorBase;
+
+        IteratorBase(const detail::ctrl_t* ctrl, value_type* slot) : _ctrl(ctrl), _slot(slot) {}
+
+        // 跳过空槽和墓碑，停在下一个满槽或末尾的哨兵上
+        void skip_free() {
+            while (*_ctrl < detail::kSentinel) {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+
+        const detail::ctrl_t* _ctrl;
+        value_type* _slot;
+    };
+
+    using iterator = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<value_type> list) {
+        reserve(list.size());
+        for (const auto& kv : list)
+            insert(kv);
+    }
+
+    FlatHashMap(const FlatHashMap& other) {
+        reserve(other.size());
+        for (const auto& kv : other)
+            insert_unique_unchecked(kv);
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& dsObj) {
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        clear();
+        reserve(dsObj.size());
+        for (const auto& kv : dsObj)
+            insert_unique_unchecked(kv);
+        return *this;
+    }
+
+    FlatHashMap(FlatHashMap&& other) { take(other); }
+
+    FlatHashMap& operator=(FlatHashMap&& dsObj) {
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        destroy();
+        take(dsObj);
+        return *this;
+    }
+
+    ~FlatHashMap() { destroy(); }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    size_t capacity() const { return _capacity; }
+    double load_factor() const { return _capacity == 0 ? 0.0 : double(_size) / double(_capacity); }
+
+    iterator begin() {
+        iterator it(_ctrl, _slots);
+        if (_size == 0) return end();
+        it.skip_free();
+        return it;
+    }
+    iterator end() { return iterator(_ctrl + _capacity, _slots + _capacity); }
+    const_iterator begin() const { return const_cast<FlatHashMap*>(this)->begin(); }
+    const_iterator end() const { return const_cast<FlatHashMap*>(this)->end(); }
+
+    iterator find(const K& key) {
+        size_t index = find_index(key);
+        return index == npos ? end() : iterator(_ctrl + index, _slots + index);
+    }
+
+    const_iterator find(const K& key) const { return const_cast<FlatHashMap*>(this)->find(key); }
+
+    bool contains(const K& key) const { return find_index(key) != npos; }
+    size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    std::pair<iterator, bool> insert(const value_type& kv) { return try_emplace(kv.first, kv.second); }
+    std::pair<iterator, bool> insert(value_type&& kv) {
+        return try_emplace(std::move(const_cast<K&>(kv.first)), std::move(kv.second));
+    }
+
+    // 键不存在时用 args 构造值；键已存在则什么也不做（args 不会被移走）
+    template<typename KK, typename... Args>
+    std::pair<iterator, bool> try_emplace(KK&& key, Args&&... args) {
+        size_t hash;
+        auto res = find_or_prepare_insert(key, hash);
+        if (res.second) {
+            // 先构造再登记：构造抛异常时控制字节和计数都还没动，表保持原样
+            new (_slots + res.first) value_type(std::piecewise_construct,
+                                                std::forward_as_tuple(std::forward<KK>(key)),
+                                                std::forward_as_tuple(std::forward<Args>(args)...));
+            commit_insert(res.first, hash);
+        }
+        return {iterator(_ctrl + res.first, _slots + res.first), res.second};
+    }
+
+    template<typename KK, typename M>
+    std::pair<iterator, bool> insert_or_assign(KK&& key, M&& value) {
+        auto res = try_emplace(std::forward<KK>(key), std::forward<M>(value));
+        if (!res.second)
+            res.first->second = std::forward<M>(value);
+        return res;
+    }
+
+    V& operator[](const K& key) { return try_emplace(key).first->second; }
+    V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+    V& at(const K& key) {
+        size_t index = find_index(key);
+        d2ds_assert(index != npos);
+        return _slots[index].second;
+    }
+
+    const V& at(const K& key) const { return const_cast<FlatHashMap*>(this)->at(key); }
+
+    size_t erase(const K& key) {
+        size_t index = find_index(key);
+        if (index == npos) return 0;
+        erase_at(index);
+        return 1;
+    }
+
+    void erase(const_iterator pos) { erase_at(size_t(pos._ctrl - _ctrl)); }
+
+    // 析构全部元素，保留容量
+    void clear() {
+        if (_capacity == 0) return;
+        destroy_slots();
+        std::memset(_ctrl, detail::kEmpty, _capacity);
+        _size = 0;
+        _growth_left = max_load(_capacity);
+    }
+
+    // 保证再插入到 n 个元素前不会扩容
+    void reserve(size_t n) {
+        if (n == 0) return;
+        size_t cap = kMinCapacity;
+        while (max_load(cap) < n) cap *= 2;
+        if (cap > _capacity) resize(cap);
+    }
+
+private:
+    static constexpr size_t npos = size_t(-1);
+    static constexpr size_t kGroup = detail::CtrlGroup::kWidth;
+    static constexpr size_t kMinCapacity = kGroup;
+
+    // 负载因子上限 7/8
+    static size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+    size_t hash_of(const K& key) const { return size_t(detail::mix_hash(uint64_t(_hash(key)))); }
+
+    static detail::ctrl_t h2(size_t hash) { return detail::ctrl_t(hash & 0x7F); }
+
+    size_t group_mask() const { return _capacity == 0 ? 0 : _capacity / kGroup - 1; }
+
+    size_t find_index(const K& key) const {
+        size_t hash = hash_of(key);
+        size_t mask = group_mask();
+        size_t group = (hash >> 7) & mask;
+        for (size_t step = 1;; ++step) {
+            detail::CtrlGroup g(_ctrl + group * kGroup);
+            for (uint32_t bits = g.match(h2(hash)); bits != 0; bits &= bits - 1) {
+                size_t index = group * kGroup + size_t(__builtin_ctz(bits));
+                if (_eq(_slots[index].first, key)) return index;
+            }
+            if (g.match_empty() != 0) return npos;
+            group = (group + step) & mask;
+        }
+    }
+
+    // 第一个可以放入新元素的槽（空槽或墓碑）
+    size_t find_free(size_t hash) const {
+        size_t mask = group_mask();
+        size_t group = (hash >> 7) & mask;
+        for (size_t step = 1;; ++step) {
+            uint32_t bits = detail::CtrlGroup(_ctrl + group * kGroup).match_empty_or_deleted();
+            if (bits != 0) return group * kGroup + size_t(__builtin_ctz(bits));
+            group = (group + step) & mask;
+        }
+    }
+
+    // 返回 (槽下标, 是否需要在该槽构造新元素)。需要构造时可能已经扩容，但控制字节和计数还没有修改，
+    // 调用方构造成功后再用 commit_insert 登记
+    std::pair<size_t, bool> find_or_prepare_insert(const K& key, size_t& hash) {
+        size_t index = find_index(key);
+        if (index != npos) return {index, false};
+        hash = hash_of(key);
+        index = find_free(hash);
+        if (_growth_left == 0 && _ctrl[index] == detail::kEmpty) {
+            // 空位用完：元素超过上限的一半就翻倍，否则多半是墓碑占了位置，原容量重建即可
+            resize(_capacity == 0 ? kMinCapacity : (_size * 2 >= max_load(_capacity) ? _capacity * 2 : _capacity));
+            index = find_free(hash);
+        }
+        return {index, true};
+    }
+
+    void commit_insert(size_t index, size_t hash) {
+        if (_ctrl[index] == detail::kEmpty) _growth_left--;
+        _ctrl[index] = h2(hash);
+        _size++;
+    }
+
+    // 拷贝时键一定不重复，跳过查找
+    void insert_unique_unchecked(const value_type& kv) {
+        size_t hash = hash_of(kv.first);
+        size_t index = find_free(hash);
+        new (_slots + index) value_type(kv);
+        _ctrl[index] = h2(hash);
+        _size++;
+        _growth_left--;
+    }
+
+    void erase_at(size_t index) {
+        _slots[index].~value_type();
+        _size--;
+        // 所在组里还有空槽：任何查找都会在这一组停下，不会依赖这个槽“被占用”继续往后探测
+        size_t group = index / kGroup;
+        if (detail::CtrlGroup(_ctrl + group * kGroup).match_empty() != 0) {
+            _ctrl[index] = detail::kEmpty;
+            _growth_left++;
+        } else {
+            _ctrl[index] = detail::kDeleted;
+        }
+    }
+
+    static size_t bytes_for(size_t capacity) {
+        return capacity * sizeof(value_type) + capacity + 1;
+    }
+
+    void resize(size_t new_capacity) {
+        detail::ctrl_t* old_ctrl = _ctrl;
+        value_type* old_slots = _slots;
+        size_t old_capacity = _capacity;
+
+        void* mem = Allocator::allocate(bytes_for(new_capacity));
+        if (mem == nullptr) throw std::bad_alloc();
+        _slots = static_cast<value_type*>(mem);
+        _ctrl = reinterpret_cast<detail::ctrl_t*>(_slots + new_capacity);
+        std::memset(_ctrl, detail::kEmpty, new_capacity);
+        _ctrl[new_capacity] = detail::kSentinel;
+        _capacity = new_capacity;
+        _growth_left = max_load(new_capacity) - _size;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (!detail::is_full(old_ctrl[i])) continue;
+            value_type& kv = old_slots[i];
+            size_t hash = hash_of(kv.first);
+            size_t index = find_free(hash);
+            // 旧元素马上析构，键可以移走
+            new (_slots + index) value_type(std::move(const_cast<K&>(kv.first)), std::move(kv.second));
+            kv.~value_type();
+            _ctrl[index] = h2(hash);
+        }
+        if (old_capacity != 0)
+            Allocator::deallocate(old_slots, bytes_for(old_capacity));
+    }
+
+    void destroy_slots() {
+        if constexpr (std::is_trivially_destructible<value_type>::value) return;
+        for (size_t i = 0; i < _capacity; ++i)
+            if (detail::is_full(_ctrl[i])) _slots[i].~value_type();
+    }
+
+    void destroy() {
+        if (_capacity == 0) return;
+        destroy_slots();
+        Allocator::deallocate(_slots, bytes_for(_capacity));
+        reset();
+    }
+
+    void reset() {
+        _ctrl = const_cast<detail::ctrl_t*>(detail::kEmptyGroup);
+        _slots = nullptr;
+        _capacity = 0;
+        _size = 0;
+        _growth_left = 0;
+    }
+
+    void take(FlatHashMap& other) {
+        _ctrl = other._ctrl;
+        _slots = other._slots;
+        _capacity = other._capacity;
+        _size = other._size;
+        _growth_left = other._growth_left;
+        other.reset();
+    }
+
+    detail::ctrl_t* _ctrl = const_cast<detail::ctrl_t*>(detail::kEmptyGroup);
+    value_type* _slots = nullptr;
+    size_t _capacity = 0;
+    size_t _size = 0;
+    size_t _growth_left = 0;
+    Hash _hash;
+    KeyEqual _eq;
+};
+
+} // namespace d2ds
+
+#endif
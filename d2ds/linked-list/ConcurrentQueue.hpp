@@ -0,0 +1,154 @@
+#ifndef CONCURRENT_QUEUE_HPP_D2DS
+#define CONCURRENT_QUEUE_HPP_D2DS
+
+#include <atomic>
+#include <optional>
+
+#include <common/common.hpp>
+#include <common/Epoch.hpp>
+#include <common/PoolAllocator.hpp>
+
+namespace d2ds {
+// show your code
+
+    template<typename T>
+    struct ConcurrentQueueNode{
+        std::atomic<ConcurrentQueueNode*> next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* data(){
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    // Michael-Scott 无锁队列（无界，多生产者多消费者）：
+    //   - 始终保留一个哑节点，head 指向哑节点，真正的队首是 head->next；
+    //   - push 先 CAS 队尾节点的 next 挂上新节点，再尽力把 tail 推到新节点（失败说明别人已经帮忙推了）；
+    //   - pop CAS head 到 head->next，成功者把新哑节点里的数据移出来，旧哑节点交给 epoch::retire；
+    //   - 节点只在所有可能持有它的线程离开临界区后才释放/复用，因此不会出现 ABA，也不需要带标签的指针。
+    // head 与 tail 分别独占缓存行，生产者和消费者互不干扰。节点默认从 PoolAllocator 分配。
+    template<typename T, typename Allocator = PoolAllocator>
+    class ConcurrentQueue{
+    public:
+        using Node = ConcurrentQueueNode<T>;
+
+        static_assert(alignof(Node) <= 8, "PoolAllocator slots are only 8-byte aligned");
+
+        ConcurrentQueue(){
+            Node* dummy=new_node();
+            _head.store(dummy,std::memory_order_relaxed);
+            _tail.store(dummy,std::memory_order_relaxed);
+        }
+
+        ConcurrentQueue(const ConcurrentQueue&)=delete;
+        ConcurrentQueue& operator=(const ConcurrentQueue&)=delete;
+
+        // 要求没有其他线程仍在访问
+        ~ConcurrentQueue(){
+            Node* dummy=_head.load(std::memory_order_relaxed);
+            Node* node=dummy->next.load(std::memory_order_relaxed);
+            Allocator::deallocate(dummy,sizeof(Node));
+            while(node!=nullptr){
+                Node* next=node->next.load(std::memory_order_relaxed);
+                node->data()->~T();
+                Allocator::deallocate(node,sizeof(Node));
+                node=next;
+            }
+        }
+
+        void push(const T& value){
+            emplace(value);
+        }
+
+        void push(T&& value){
+            emplace(std::move(value));
+        }
+
+        template<typename... Args>
+        void emplace(Args&&... args){
+            Node* node=new_node();
+            try{
+                new (node->data()) T(std::forward<Args>(args)...);
+            }catch(...){
+                Allocator::deallocate(node,sizeof(Node));
+                throw;
+            }
+            epoch::Guard guard;
+            while(true){
+                Node* tail=_tail.load(std::memory_order_acquire);
+                Node* next=tail->next.load(std::memory_order_acquire);
+                if(tail!=_tail.load(std::memory_order_acquire))
+                    continue;
+                if(next!=nullptr){
+                    // tail 落后了，帮忙推进
+                    _tail.compare_exchange_weak(tail,next,std::memory_order_release,std::memory_order_relaxed);
+                    continue;
+                }
+                if(tail->next.compare_exchange_weak(next,node,std::memory_order_release,std::memory_order_relaxed)){
+                    _tail.compare_exchange_strong(tail,node,std::memory_order_release,std::memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+
+        // 队列为空时返回 false
+        bool try_pop(T& out){
+            return pop_with([&out](T& value){ out=std::move(value); });
+        }
+
+        std::optional<T> try_pop(){
+            std::optional<T> result;
+            pop_with([&result](T& value){ result.emplace(std::move(value)); });
+            return result;
+        }
+
+        // 只是某一时刻的快照
+        bool empty() const{
+            epoch::Guard guard;
+            return _head.load(std::memory_order_acquire)->next.load(std::memory_order_acquire)==nullptr;
+        }
+
+    private:
+        template<typename F>
+        bool pop_with(F consume){
+            epoch::Guard guard;
+            while(true){
+                Node* head=_head.load(std::memory_order_acquire);
+                Node* tail=_tail.load(std::memory_order_acquire);
+                Node* next=head->next.load(std::memory_order_acquire);
+                if(head!=_head.load(std::memory_order_acquire))
+                    continue;
+                if(next==nullptr)
+                    return false;
+                if(head==tail){
+                    _tail.compare_exchange_weak(tail,next,std::memory_order_release,std::memory_order_relaxed);
+                    continue;
+                }
+                // 摘除用 seq_cst：retire 时读取的全局纪元必须排在它之后
+                if(_head.compare_exchange_strong(head,next,std::memory_order_seq_cst,std::memory_order_relaxed)){
+                    // next 成为新的哑节点，其中的数据只有 CAS 成功者会访问
+                    consume(*next->data());
+                    next->data()->~T();
+                    epoch::retire(head,&ConcurrentQueue::free_node);
+                    return true;
+                }
+            }
+        }
+
+        static Node* new_node(){
+            Node* node=static_cast<Node*>(Allocator::allocate(sizeof(Node)));
+            new (&node->next) std::atomic<Node*>(nullptr);
+            return node;
+        }
+
+        // 被 retire 的总是哑节点，数据已经移走
+        static void free_node(void* p){
+            Allocator::deallocate(p,sizeof(Node));
+        }
+
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> _head;
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> _tail;
+    };
+}
+
+#endif
@@ -0,0 +1,315 @@
+#ifndef CONCURRENT_SKIP_LIST_HPP_D2DS
+#define CONCURRENT_SKIP_LIST_HPP_D2DS
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+#include <common/common.hpp>
+#include <common/Epoch.hpp>
+#include <common/PoolAllocator.hpp>
+
+namespace d2ds {
+// show your code
+
+    // 跳表节点：与 SLinkedListNode 一样是“next 指针 + 数据”，只是 next 变成了 height 层的塔，
+    // 紧跟在节点头之后一起分配。每层指针的最低位是删除标记（节点至少 8 字节对齐）。
+    template<typename K, typename V>
+    struct SkipListNode{
+        using Link = std::atomic<uintptr_t>;
+
+        unsigned int height;
+        std::atomic<unsigned int> state; // INSERT_DONE / ERASE_DONE，决定由谁回收
+        alignas(K) unsigned char key_storage[sizeof(K)];
+        alignas(V) unsigned char value_storage[sizeof(V)];
+
+        static constexpr size_t kTowerOffset = (sizeof(SkipListNode)+alignof(Link)-1)/alignof(Link)*alignof(Link);
+
+        static size_t bytes(unsigned int height){
+            return kTowerOffset+sizeof(Link)*height;
+        }
+
+        Link* next(){
+            return reinterpret_cast<Link*>(reinterpret_cast<unsigned char*>(this)+kTowerOffset);
+        }
+
+        const Link* next() const{
+            return reinterpret_cast<const Link*>(reinterpret_cast<const unsigned char*>(this)+kTowerOffset);
+        }
+
+        const K& key() const{
+            return *reinterpret_cast<const K*>(key_storage);
+        }
+
+        const V& value() const{
+            return *reinterpret_cast<const V*>(value_storage);
+        }
+    };
+
+    // 无锁跳表（有序 map，键唯一，值插入后不再修改）：
+    //   - 插入：底层一次 CAS 完成“逻辑插入”，再逐层向上链接；
+    //   - 删除：自顶向下给每层 next 打删除标记，底层打标记成功的线程赢得删除，随后的查找会顺手把标记节点摘掉；
+    //   - 查找 / contains / scan 只读不写，是无等待的遍历，遇到带标记的节点直接跳过；
+    //   - 节点塔从 Allocator（默认 PoolAllocator）按高度分配，摘除后交给 epoch::retire 延迟释放。
+    // 插入者可能在删除者摘除节点之后才把它链接到更高层，所以节点的回收由“插入完成”和“删除完成”
+    // 两方中后完成的一方负责：它再做一次以该节点为目标的查找，确保各层都已摘除，然后 retire。
+    // size() 和 scan() 是弱一致的：并发修改时可能看到也可能看不到正在插入/删除的元素。
+    template<typename K, typename V, typename Compare = std::less<K>, typename Allocator = PoolAllocator>
+    class ConcurrentSkipList{
+    public:
+        using Node = SkipListNode<K, V>;
+        static constexpr unsigned int kMaxLevel = 16; // 每层概率 1/4，足够 40 亿个元素
+
+        static_assert(alignof(Node) <= 8, "PoolAllocator slots are only 8-byte aligned");
+
+        ConcurrentSkipList(){
+            _head=static_cast<Node*>(Allocator::allocate(Node::bytes(kMaxLevel)));
+            _head->height=kMaxLevel;
+            new (&_head->state) std::atomic<unsigned int>(INSERT_DONE);
+            for(unsigned int l=0;l<kMaxLevel;l++)
+                new (_head->next()+l) typename Node::Link(0);
+        }
+
+        ConcurrentSkipList(const ConcurrentSkipList&)=delete;
+        ConcurrentSkipList& operator=(const ConcurrentSkipList&)=delete;
+
+        // 要求没有其他线程仍在访问；已 retire 的节点由 epoch 模块稍后释放
+        ~ConcurrentSkipList(){
+            Node* node=ptr(_head->next()[0].load(std::memory_order_acquire));
+            while(node!=nullptr){
+                Node* next=ptr(node->next()[0].load(std::memory_order_relaxed));
+                free_node(node);
+                node=next;
+            }
+            Allocator::deallocate(_head,Node::bytes(kMaxLevel));
+        }
+
+        // 键已存在时返回 false
+        bool insert(const K& key, const V& value){
+            epoch::Guard guard;
+            Node* preds[kMaxLevel];
+            Node* succs[kMaxLevel];
+            unsigned int height=random_height();
+            Node* node=nullptr;
+            while(true){
+                if(search(key,preds,succs)){
+                    if(node!=nullptr) free_node(node);
+                    return false;
+                }
+                if(node==nullptr) node=new_node(height,key,value);
+                for(unsigned int l=0;l<height;l++)
+                    node->next()[l].store(uintptr_t(succs[l]),std::memory_order_relaxed);
+                uintptr_t expected=uintptr_t(succs[0]);
+                if(preds[0]->next()[0].compare_exchange_strong(expected,uintptr_t(node),std::memory_order_acq_rel))
+                    break;
+            }
+            link_upper_levels(node,preds,succs);
+            unsigned int prev=node->state.fetch_or(INSERT_DONE,std::memory_order_acq_rel);
+            if(prev&ERASE_DONE)
+                unlink_and_retire(node);
+            return true;
+        }
+
+        bool erase(const K& key){
+            epoch::Guard guard;
+            Node* preds[kMaxLevel];
+            Node* succs[kMaxLevel];
+            if(!search(key,preds,succs))
+                return false;
+            Node* node=succs[0];
+            for(unsigned int l=node->height-1;l>=1;l--)
+                node->next()[l].fetch_or(1,std::memory_order_acq_rel);
+            uintptr_t prev=node->next()[0].fetch_or(1,std::memory_order_acq_rel);
+            if(marked(prev))
+                return false; // 另一个线程先删掉了
+            unsigned int state=node->state.fetch_or(ERASE_DONE,std::memory_order_acq_rel);
+            if(state&INSERT_DONE)
+                unlink_and_retire(node);
+            else
+                search(key,preds,succs,node); // 插入者还在链接上层，由它负责回收，这里只帮忙摘除
+            return true;
+        }
+
+        bool contains(const K& key) const{
+            epoch::Guard guard;
+            const Node* node=lower_bound_node(key);
+            return node!=nullptr && !_less(key,node->key());
+        }
+
+        // 值在临界区内拷贝出来，返回后与节点的生命周期无关
+        std::optional<V> find(const K& key) const{
+            epoch::Guard guard;
+            const Node* node=lower_bound_node(key);
+            if(node!=nullptr && !_less(key,node->key()))
+                return node->value();
+            return std::nullopt;
+        }
+
+        // 按键升序对 [lo, hi) 内的元素调用 f(key, value)
+        template<typename F>
+        void scan(const K& lo, const K& hi, F f) const{
+            epoch::Guard guard;
+            for(const Node* node=lower_bound_node(lo);node!=nullptr && _less(node->key(),hi);){
+                uintptr_t succ=node->next()[0].load(std::memory_order_acquire);
+                if(!marked(succ))
+                    f(node->key(),node->value());
+                node=ptr(succ);
+            }
+        }
+
+        template<typename F>
+        void for_each(F f) const{
+            epoch::Guard guard;
+            for(const Node* node=ptr(_head->next()[0].load(std::memory_order_acquire));node!=nullptr;){
+                uintptr_t succ=node->next()[0].load(std::memory_order_acquire);
+                if(!marked(succ))
+                    f(node->key(),node->value());
+                node=ptr(succ);
+            }
+        }
+
+        // O(n) 遍历底层计数
+        size_t size() const{
+            size_t n=0;
+            for_each([&n](const K&, const V&){ n++; });
+            return n;
+        }
+
+        bool empty() const{
+            return size()==0;
+        }
+
+    private:
+        static constexpr unsigned int INSERT_DONE=1;
+        static constexpr unsigned int ERASE_DONE=2;
+
+        static Node* ptr(uintptr_t link){
+            return reinterpret_cast<Node*>(link&~uintptr_t(1));
+        }
+
+        static bool marked(uintptr_t link){
+            return (link&1)!=0;
+        }
+
+        static unsigned int random_height(){
+            thread_local uint64_t x=0x9E3779B97F4A7C15ull^uint64_t(reinterpret_cast<uintptr_t>(&x));
+            x^=x<<13; x^=x>>7; x^=x<<17;
+            unsigned int height=1;
+            for(uint64_t r=x;(r&3)==0 && height<kMaxLevel;r>>=2)
+                height++;
+            return height;
+        }
+
+        static Node* new_node(unsigned int height, const K& key, const V& value){
+            Node* node=static_cast<Node*>(Allocator::allocate(Node::bytes(height)));
+            node->height=height;
+            new (&node->state) std::atomic<unsigned int>(0);
+            try{
+                new (node->key_storage) K(key);
+                try{
+                    new (node->value_storage) V(value);
+                }catch(...){
+                    reinterpret_cast<K*>(node->key_storage)->~K();
+                    throw;
+                }
+            }catch(...){
+                Allocator::deallocate(node,Node::bytes(height));
+                throw;
+            }
+            for(unsigned int l=0;l<height;l++)
+                new (node->next()+l) typename Node::Link(0);
+            return node;
+        }
+
+        static void free_node(void* p){
+            Node* node=static_cast<Node*>(p);
+            reinterpret_cast<const K*>(node->key_storage)->~K();
+            reinterpret_cast<const V*>(node->value_storage)->~V();
+            Allocator::deallocate(node,Node::bytes(node->height));
+        }
+
+        // 逐层找到 key 的前驱/后继，顺手摘除遇到的带标记节点。
+        // target 非空时越过键相等但不是 target 的节点，用于确保 target 在每层都被摘除。
+        // 返回底层后继是否为未删除的、键等于 key 的节点
+        bool search(const K& key, Node** preds, Node** succs, const Node* target=nullptr){
+        retry:
+            Node* pred=_head;
+            for(int l=kMaxLevel-1;l>=0;l--){
+                Node* curr=ptr(pred->next()[l].load(std::memory_order_acquire));
+                while(curr!=nullptr){
+                    uintptr_t succ=curr->next()[l].load(std::memory_order_acquire);
+                    if(marked(succ)){
+                        // 摘除用 seq_cst：retire 时读取的全局纪元必须排在它之后
+                        uintptr_t expected=uintptr_t(curr);
+                        if(!pred->next()[l].compare_exchange_strong(expected,succ&~uintptr_t(1),std::memory_order_seq_cst))
+                            goto retry;
+                        curr=ptr(succ);
+                        continue;
+                    }
+                    if(_less(curr->key(),key) || (target!=nullptr && curr!=target && !_less(key,curr->key()))){
+                        pred=curr;
+                        curr=ptr(succ);
+                    }else{
+                        break;
+                    }
+                }
+                preds[l]=pred;
+                succs[l]=curr;
+            }
+            return succs[0]!=nullptr && !_less(key,succs[0]->key());
+        }
+
+        void link_upper_levels(Node* node, Node** preds, Node** succs){
+            for(unsigned int l=1;l<node->height;l++){
+                while(true){
+                    uintptr_t cur=node->next()[l].load(std::memory_order_acquire);
+                    if(marked(cur))
+                        return; // 已被删除，不再往上链接
+                    if(ptr(cur)!=succs[l] &&
+                       !node->next()[l].compare_exchange_strong(cur,uintptr_t(succs[l]),std::memory_order_acq_rel))
+                        continue;
+                    uintptr_t expected=uintptr_t(succs[l]);
+                    if(preds[l]->next()[l].compare_exchange_strong(expected,uintptr_t(node),std::memory_order_acq_rel))
+                        break;
+                    search(node->key(),preds,succs,node);
+                    if(succs[0]!=node)
+                        return; // 底层已被摘除
+                }
+            }
+        }
+
+        // 插入与删除都已完成：保证各层都已摘除后交给 epoch 回收
+        void unlink_and_retire(Node* node){
+            Node* preds[kMaxLevel];
+            Node* succs[kMaxLevel];
+            search(node->key(),preds,succs,node);
+            epoch::retire(node,&ConcurrentSkipList::free_node);
+        }
+
+        // 底层第一个未删除且键 >= key 的节点
+        const Node* lower_bound_node(const K& key) const{
+            const Node* pred=_head;
+            const Node* curr=nullptr;
+            for(int l=kMaxLevel-1;l>=0;l--){
+                curr=ptr(pred->next()[l].load(std::memory_order_acquire));
+                while(curr!=nullptr){
+                    uintptr_t succ=curr->next()[l].load(std::memory_order_acquire);
+                    if(marked(succ)){
+                        curr=ptr(succ);
+                        continue;
+                    }
+                    if(!_less(curr->key(),key)) break;
+                    pred=curr;
+                    curr=ptr(succ);
+                }
+            }
+            return curr;
+        }
+
+        Node* _head;
+        Compare _less;
+    };
+}
+
+#endif
@@ -1,13 +1,28 @@
 #ifndef EMBEDDED_LIST_HPP_D2DS
 #define EMBEDDED_LIST_HPP_D2DS
 
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#include <common/common.hpp>
+
 namespace d2ds {
 // show your code
 
+    // 单向链接：未挂在链表上时指向自己。
+    // 与 DoublyLink 一样，拷贝对象时不拷贝链接关系（新对象总是未链接的），避免副本看起来“已链接”并与原对象共用 next
     struct SinglyLink{
         struct SinglyLink * next;
 
         SinglyLink():next{this}{}
+        SinglyLink(const SinglyLink&):SinglyLink(){}
+        SinglyLink& operator=(const SinglyLink&){ return *this; }
+
+        bool linked() const{
+            return next!=this;
+        }
 
         static void insert(struct SinglyLink* prev, struct SinglyLink* target){
             target->next=prev->next;
@@ -20,6 +35,398 @@ namespace d2ds {
         }
     };
 
+    // 双向链接：与 SinglyLink 一样，未挂在链表上时指向自己。
+    // 拷贝对象时不拷贝链接关系（新对象总是未链接的），避免两个对象共用同一组前后指针
+    struct DoublyLink{
+        struct DoublyLink * prev;
+        struct DoublyLink * next;
+
+        DoublyLink():prev{this},next{this}{}
+        DoublyLink(const DoublyLink&):DoublyLink(){}
+        DoublyLink& operator=(const DoublyLink&){ return *this; }
+
+        bool linked() const{
+            return next!=this;
+        }
+
+        // 把 target 插到 pos 之前
+        static void insert(struct DoublyLink* pos, struct DoublyLink* target){
+            target->prev=pos->prev;
+            target->next=pos;
+            pos->prev->next=target;
+            pos->prev=target;
+        }
+
+        static void remove(struct DoublyLink* target){
+            target->prev->next=target->next;
+            target->next->prev=target->prev;
+            target->prev=target->next=target;
+        }
+
+        // 把 [first, last] 这一段（last 是段内最后一个）从原位置摘下，插到 pos 之前
+        static void transfer(struct DoublyLink* pos, struct DoublyLink* first, struct DoublyLink* last){
+            first->prev->next=last->next;
+            last->next->prev=first->prev;
+            first->prev=pos->prev;
+            last->next=pos;
+            pos->prev->next=first;
+            pos->prev=last;
+        }
+    };
+
+    // container_of：由成员（链接）的地址反推所属对象的地址。
+    // 只支持标准布局类型：成员相对对象起始的偏移是固定的，不受虚基类等影响。
+    // 偏移直接取自数据成员指针的表示——Itanium C++ ABI（GCC / Clang）把它存为一个 ptrdiff_t 偏移，
+    // 这样不需要在一块没有构造过对象的内存上做成员访问（那是未定义行为）
+    template<typename T, typename Link>
+    size_t member_offset(Link T::* member){
+        static_assert(std::is_standard_layout<T>::value, "intrusive links need a standard-layout element type");
+        static_assert(sizeof(member)==sizeof(std::ptrdiff_t), "data member pointer is expected to be a plain offset");
+        std::ptrdiff_t offset;
+        std::memcpy(&offset,&member,sizeof(offset));
+        return size_t(offset);
+    }
+
+    template<typename T, typename Link>
+    T* container_of(Link* link, Link T::* member){
+        return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(link)-member_offset(member));
+    }
+
+    template<typename T, typename Link>
+    const T* container_of(const Link* link, Link T::* member){
+        return reinterpret_cast<const T*>(reinterpret_cast<const unsigned char*>(link)-member_offset(member));
+    }
+
+    // 侵入式单链表：元素是已存在的对象，通过其 SinglyLink 成员挂到表上，链表本身不分配也不释放任何内存。
+    // 一个对象有几个 SinglyLink 成员就能同时挂在几条链表上，例如
+    //     struct Conn{ SinglyLink free_link; SinglyLink timeout_link; ... };
+    //     IntrusiveSList<Conn, &Conn::free_link> free_conns;
+    // 内部是带哨兵的循环链表并记录表尾：头插/尾插/弹出表头/拼接整条链表 O(1)，删除需要前驱（erase_after）。
+    // 对象在链表上时不能销毁；链表析构时把剩余元素的链接复位为“未链接”。
+    template<typename T, SinglyLink T::* Member>
+    class IntrusiveSList{
+    public:
+        class Iterator{
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            Iterator(SinglyLink* link=nullptr):_link{link}{}
+
+            T& operator*() const{ return *IntrusiveSList::to_object(_link); }
+            T* operator->() const{ return IntrusiveSList::to_object(_link); }
+
+            Iterator& operator++(){
+                _link=_link->next;
+                return *this;
+            }
+
+            Iterator operator++(int){
+                Iterator old=*this;
+                _link=_link->next;
+                return old;
+            }
+
+            bool operator==(const Iterator& it) const{ return _link==it._link; }
+            bool operator!=(const Iterator& it) const{ return _link!=it._link; }
+
+        private:
+            friend class IntrusiveSList;
+            SinglyLink* _link;
+        };
+
+        IntrusiveSList():_tail{&_head}{}
+
+        IntrusiveSList(const IntrusiveSList&)=delete;
+        IntrusiveSList& operator=(const IntrusiveSList&)=delete;
+
+        IntrusiveSList(IntrusiveSList&& other):IntrusiveSList(){
+            splice_back(other);
+        }
+
+        IntrusiveSList& operator=(IntrusiveSList&& dsObj){
+            D2DS_SELF_ASSIGNMENT_CHECKER;
+            clear();
+            splice_back(dsObj);
+            return *this;
+        }
+
+        ~IntrusiveSList(){
+            clear();
+        }
+
+        static T* to_object(SinglyLink* link){ return container_of(link,Member); }
+        static const T* to_object(const SinglyLink* link){ return container_of(link,Member); }
+
+        static bool is_linked(const T& obj){
+            return (obj.*Member).linked();
+        }
+
+        bool empty() const{ return _head.next==&_head; }
+
+        // O(n)
+        size_t size() const{
+            size_t n=0;
+            for(const SinglyLink* l=_head.next;l!=&_head;l=l->next) n++;
+            return n;
+        }
+
+        T& front(){ d2ds_assert(!empty()); return *to_object(_head.next); }
+        T& back(){ d2ds_assert(!empty()); return *to_object(_tail); }
+
+        void push_front(T& obj){
+            insert_after(before_begin(),obj);
+        }
+
+        void push_back(T& obj){
+            insert_after(Iterator(_tail),obj);
+        }
+
+        T& pop_front(){
+            d2ds_assert(!empty());
+            T& obj=front();
+            erase_after(before_begin());
+            return obj;
+        }
+
+        Iterator insert_after(Iterator pos, T& obj){
+            SinglyLink* link=&(obj.*Member);
+            d2ds_assert(!link->linked()); // 对象已经在某条链表上
+            SinglyLink::insert(pos._link,link);
+            if(pos._link==_tail) _tail=link;
+            return Iterator(link);
+        }
+
+        // 摘下 pos 之后的元素，返回被摘下元素之后的位置
+        Iterator erase_after(Iterator pos){
+            SinglyLink* target=pos._link->next;
+            d2ds_assert(target!=&_head);
+            if(target==_tail) _tail=pos._link;
+            SinglyLink::remove(pos._link,target);
+            return Iterator(pos._link->next);
+        }
+
+        // O(n)：单链表只能从头找前驱
+        bool remove(T& obj){
+            SinglyLink* target=&(obj.*Member);
+            for(SinglyLink* prev=&_head;prev->next!=&_head;prev=prev->next){
+                if(prev->next==target){
+                    erase_after(Iterator(prev));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // 把 other 的全部元素接到表尾，O(1)
+        void splice_back(IntrusiveSList& other){
+            if(&other==this || other.empty()) return;
+            _tail->next=other._head.next;
+            other._tail->next=&_head;
+            _tail=other._tail;
+            other._head.next=&other._head;
+            other._tail=&other._head;
+        }
+
+        // 把 other 的全部元素插到 pos 之后，O(1)
+        void splice_after(Iterator pos, IntrusiveSList& other){
+            if(&other==this || other.empty()) return;
+            other._tail->next=pos._link->next;
+            pos._link->next=other._head.next;
+            if(pos._link==_tail) _tail=other._tail;
+            other._head.next=&other._head;
+            other._tail=&other._head;
+        }
+
+        // 摘下全部元素并复位它们的链接，O(n)
+        void clear(){
+            SinglyLink* link=_head.next;
+            while(link!=&_head){
+                SinglyLink* next=link->next;
+                link->next=link;
+                link=next;
+            }
+            _head.next=&_head;
+            _tail=&_head;
+        }
+
+        Iterator before_begin(){ return Iterator(&_head); }
+        Iterator begin(){ return Iterator(_head.next); }
+        Iterator end(){ return Iterator(&_head); }
+
+    private:
+        SinglyLink _head; // 哨兵
+        SinglyLink* _tail;
+    };
+
+    // 侵入式双向链表：用法同 IntrusiveSList，链接成员换成 DoublyLink。
+    // 已知对象即可 O(1) 摘除（erase / unlink），splice 可以在两条链表之间 O(1) 移动单个元素或一整段。
+    template<typename T, DoublyLink T::* Member>
+    class IntrusiveList{
+    public:
+        template<bool Const>
+        class IteratorBase{
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::conditional<Const, const T*, T*>::type;
+            using reference = typename std::conditional<Const, const T&, T&>::type;
+            using LinkPtr = typename std::conditional<Const, const DoublyLink*, DoublyLink*>::type;
+
+            IteratorBase(LinkPtr link=nullptr):_link{link}{}
+            // Iterator 可以隐式转换为 ConstIterator
+            template<bool C=Const, typename=typename std::enable_if<C>::type>
+            IteratorBase(const IteratorBase<false>& it):_link{it._link}{}
+
+            reference operator*() const{ return *IntrusiveList::to_object(_link); }
+            pointer operator->() const{ return IntrusiveList::to_object(_link); }
+
+            IteratorBase& operator++(){ _link=_link->next; return *this; }
+            IteratorBase operator++(int){ IteratorBase old=*this; _link=_link->next; return old; }
+            IteratorBase& operator--(){ _link=_link->prev; return *this; }
+            IteratorBase operator--(int){ IteratorBase old=*this; _link=_link->prev; return old; }
+
+            bool operator==(const IteratorBase& it) const{ return _link==it._link; }
+            bool operator!=(const IteratorBase& it) const{ return _link!=it._link; }
+
+        private:
+            friend class IntrusiveList;
+            template<bool> friend class IteratorBase;
+            LinkPtr _link;
+        };
+
+        using Iterator = IteratorBase<false>;
+        using ConstIterator = IteratorBase<true>;
+
+        IntrusiveList()=default;
+
+        IntrusiveList(const IntrusiveList&)=delete;
+        IntrusiveList& operator=(const IntrusiveList&)=delete;
+
+        IntrusiveList(IntrusiveList&& other){
+            splice(end(),other);
+        }
+
+        IntrusiveList& operator=(IntrusiveList&& dsObj){
+            D2DS_SELF_ASSIGNMENT_CHECKER;
+            clear();
+            splice(end(),dsObj);
+            return *this;
+        }
+
+        ~IntrusiveList(){
+            clear();
+        }
+
+        static T* to_object(DoublyLink* link){ return container_of(link,Member); }
+        static const T* to_object(const DoublyLink* link){ return container_of(link,Member); }
+
+        static bool is_linked(const T& obj){
+            return (obj.*Member).linked();
+        }
+
+        // 不需要知道对象在哪条链表上就能 O(1) 摘除
+        static void unlink(T& obj){
+            DoublyLink::remove(&(obj.*Member));
+        }
+
+        static Iterator iterator_to(T& obj){
+            return Iterator(&(obj.*Member));
+        }
+
+        bool empty() const{ return _head.next==&_head; }
+
+        // O(n)
+        size_t size() const{
+            size_t n=0;
+            for(const DoublyLink* l=_head.next;l!=&_head;l=l->next) n++;
+            return n;
+        }
+
+        T& front(){ d2ds_assert(!empty()); return *to_object(_head.next); }
+        T& back(){ d2ds_assert(!empty()); return *to_object(_head.prev); }
+        const T& front() const{ d2ds_assert(!empty()); return *to_object(_head.next); }
+        const T& back() const{ d2ds_assert(!empty()); return *to_object(_head.prev); }
+
+        void push_front(T& obj){ insert(begin(),obj); }
+        void push_back(T& obj){ insert(end(),obj); }
+
+        T& pop_front(){
+            d2ds_assert(!empty());
+            T& obj=front();
+            unlink(obj);
+            return obj;
+        }
+
+        T& pop_back(){
+            d2ds_assert(!empty());
+            T& obj=back();
+            unlink(obj);
+            return obj;
+        }
+
+        // 把 obj 插到 pos 之前
+        Iterator insert(Iterator pos, T& obj){
+            DoublyLink* link=&(obj.*Member);
+            d2ds_assert(!link->linked()); // 对象已经在某条链表上
+            DoublyLink::insert(pos._link,link);
+            return Iterator(link);
+        }
+
+        // 摘下 pos 处的元素，返回其后的位置
+        Iterator erase(Iterator pos){
+            d2ds_assert(pos._link!=&_head);
+            DoublyLink* next=pos._link->next;
+            DoublyLink::remove(pos._link);
+            return Iterator(next);
+        }
+
+        void erase(T& obj){
+            unlink(obj);
+        }
+
+        // 把 other 的全部元素移到 pos 之前
+        void splice(Iterator pos, IntrusiveList& other){
+            if(other.empty()) return;
+            DoublyLink::transfer(pos._link,other._head.next,other._head.prev);
+        }
+
+        // 把 it 处的一个元素（可以来自任意链表，包括本表）移到 pos 之前
+        void splice(Iterator pos, IntrusiveList&, Iterator it){
+            if(it==pos || it._link->next==pos._link) return;
+            DoublyLink::transfer(pos._link,it._link,it._link);
+        }
+
+        // 把 [first, last) 移到 pos 之前；pos 不能落在 [first, last) 之内
+        void splice(Iterator pos, IntrusiveList&, Iterator first, Iterator last){
+            if(first==last) return;
+            DoublyLink::transfer(pos._link,first._link,last._link->prev);
+        }
+
+        // 摘下全部元素并复位它们的链接，O(n)
+        void clear(){
+            DoublyLink* link=_head.next;
+            while(link!=&_head){
+                DoublyLink* next=link->next;
+                link->prev=link->next=link;
+                link=next;
+            }
+            _head.prev=_head.next=&_head;
+        }
+
+        Iterator begin(){ return Iterator(_head.next); }
+        Iterator end(){ return Iterator(&_head); }
+        ConstIterator begin() const{ return ConstIterator(_head.next); }
+        ConstIterator end() const{ return ConstIterator(&_head); }
+
+    private:
+        DoublyLink _head; // 哨兵
+    };
+
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,7 +1,12 @@
 #ifndef SLINKED_LIST_HPP_D2DS
 #define SLINKED_LIST_HPP_D2DS
 
+#include <functional>
+#include <utility>
+
 #include <common/common.hpp>
+#include <common/PoolAllocator.hpp>
+#include <common/NodeSlab.hpp>
 
 namespace d2ds {
 // show your code
@@ -51,8 +56,41 @@ namespace d2ds {
 
     };
 
-    template<typename T,typename Allocator=DefaultAllocator>
-    class SLinkedList{
+    // 节点的申请/释放：普通分配器直接转发给它的静态接口；
+    // Allocator 为 Slab<...> 时由链表自己持有一个 NodeSlab，节点从链表自有的大块中切出
+    template<typename Node,typename Allocator,bool=is_slab<Allocator>::value>
+    struct SLinkedListNodeStore{
+        Node* allocate_node(){
+            return static_cast<Node*>(Allocator::allocate(sizeof(Node)));
+        }
+        void deallocate_node(Node* nodeptr){
+            Allocator::deallocate(nodeptr,sizeof(Node));
+        }
+        void release_all_nodes(){}
+        void take_nodes(SLinkedListNodeStore&){}
+    };
+
+    template<typename Node,typename Allocator>
+    struct SLinkedListNodeStore<Node,Allocator,true>{
+        Node* allocate_node(){
+            return static_cast<Node*>(slab.allocate());
+        }
+        void deallocate_node(Node* nodeptr){
+            slab.deallocate(nodeptr);
+        }
+        void release_all_nodes(){
+            slab.release_all();
+        }
+        void take_nodes(SLinkedListNodeStore& other){
+            slab=std::move(other.slab);
+        }
+        typename Allocator::template Store<Node> slab;
+    };
+
+    // 节点大小固定且频繁申请释放，默认走内存池；
+    // 传入 Slab<> 则节点连续地分配在链表自有的块中，T 可平凡析构时析构/整体赋值直接整块归还，不遍历节点
+    template<typename T,typename Allocator=PoolAllocator>
+    class SLinkedList : private SLinkedListNodeStore<SLinkedListNode<T>,Allocator>{
     public:
         using Node = SLinkedListNode<T>;
         using Iterator = SLinkedListIterator<T>;
@@ -70,7 +108,7 @@ namespace d2ds {
 
         SLinkedList& operator=(const SLinkedList &other){
             if(this==&other) return *this;
-            this->~SLinkedList();
+            destroy_nodes();
             for(auto it=&other.head;it->next!=&other.head;it=it->next){
                 push_back(it->next->data);
             }
@@ -78,6 +116,7 @@ namespace d2ds {
         }
 
         SLinkedList(SLinkedList&& other):SLinkedList(){
+            this->take_nodes(other);
             _size=other._size;
             head.next=other.head.next;
             tail=other.tail;
@@ -92,7 +131,8 @@ namespace d2ds {
 
         SLinkedList& operator=(SLinkedList&& other){
             if(this!=&other){
-                this->~SLinkedList();
+                destroy_nodes();
+                this->take_nodes(other);
                 _size=other._size;
                 head.next=other.head.next;
                 tail=other.tail;
@@ -107,18 +147,11 @@ namespace d2ds {
         }
 
         ~SLinkedList(){
-            for(auto it=&head;it->next!=&head;){
-                auto nodeptr = it->next;
-                it->next = nodeptr->next;
-                nodeptr->data.~T();
-                Allocator::deallocate(nodeptr,sizeof(Node));
-            }
-            _size=0;
-            tail=&head;
+            destroy_nodes();
         }
 
         void push_back(const T& t){
-            auto nodeptr = static_cast<Node*>(Allocator::allocate(sizeof(Node)));
+            auto nodeptr = this->allocate_node();
             new (&nodeptr->data) T(t);
             nodeptr->next = tail->next;
             tail->next = nodeptr;
@@ -132,13 +165,13 @@ namespace d2ds {
             while(it->next!=tail) it=it->next;
             it->next=tail->next;
             tail->data.~T();
-            Allocator::deallocate(tail,sizeof(Node));
+            this->deallocate_node(tail);
             tail = it;
             _size--;
         }
 
         void push_front(const T&t){
-            auto nodeptr = static_cast<Node*>(Allocator::allocate(sizeof(Node)));
+            auto nodeptr = this->allocate_node();
             new (&nodeptr->data) T(t);
 
             nodeptr->next = head.next;
@@ -154,7 +187,7 @@ namespace d2ds {
 
             head.next = nodeptr->next; 
             nodeptr->data.~T();
-            Allocator::deallocate(nodeptr,sizeof(Node));
+            this->deallocate_node(nodeptr);
             _size--;
 
             if(_size==0) tail = &head;
@@ -192,21 +225,20 @@ namespace d2ds {
             return &head;
         }
 
+        // 删掉的是最后一个节点时 it 成为新的表尾；splice_after / merge / sort 都依赖 tail 正确
         void erase_after(Iterator& it){
             auto nodeptr=it._nodeptr->next;
             if(nodeptr!=&head){
                 it._nodeptr->next=nodeptr->next;
+                if(nodeptr==tail) tail=it._nodeptr;
                 _size--;
                 nodeptr->data.~T();
-                Allocator::deallocate(nodeptr,sizeof(Node));
-            }   
-            if(it._nodeptr->next==&head){
-                tail=&head;
+                this->deallocate_node(nodeptr);
             }
         }
 
         void insert_after(Iterator pos, const T &data) {
-            auto nodePtr = static_cast<Node *>(Allocator::allocate(sizeof(Node)));
+            auto nodePtr = this->allocate_node();
             new (&(nodePtr->data)) T(data);
             nodePtr->next = pos._nodeptr->next;
             pos._nodeptr->next = nodePtr;
@@ -216,7 +248,252 @@ namespace d2ds {
             }
         }
 
-    private:    
+        Iterator before_begin(){
+            return &head;
+        }
+
+        // 在 pos 之后插入 [first, last)：新节点先串成一条链，再一次挂到 pos 之后；
+        // 构造元素时抛出异常则释放已建好的节点，链表保持不变。返回最后插入的元素的位置
+        template<typename InputIt>
+        Iterator insert_after(Iterator pos, InputIt first, InputIt last){
+            Node* chain=nullptr;
+            Node** link=&chain;
+            Node* lastNode=nullptr;
+            unsigned int count=0;
+            try{
+                for(;first!=last;++first){
+                    auto nodePtr=this->allocate_node();
+                    try{
+                        new (&(nodePtr->data)) T(*first);
+                    }catch(...){
+                        this->deallocate_node(nodePtr);
+                        throw;
+                    }
+                    *link=nodePtr;
+                    link=&nodePtr->next;
+                    lastNode=nodePtr;
+                    count++;
+                }
+            }catch(...){
+                *link=nullptr;
+                free_chain(chain);
+                throw;
+            }
+            if(count==0) return pos;
+            link_after(pos._nodeptr,chain,lastNode,count);
+            return lastNode;
+        }
+
+        // 把 other 的全部元素接到 pos 之后：借助 other.tail 直接找到末尾，O(1)。
+        // 两个 Slab 链表之间要逐个重新分配并移动元素，O(other.size())，见 take_range
+        void splice_after(Iterator pos, SLinkedList& other){
+            if(&other==this || other.empty()) return;
+            unsigned int count=other._size;
+            auto range=take_range(other,&other.head,other.tail,count);
+            link_after(pos._nodeptr,range.first,range.second,count);
+        }
+
+        // 把 other 中 it 之后的那一个元素移到 pos 之后（other 可以就是本链表）
+        void splice_after(Iterator pos, SLinkedList& other, Iterator it){
+            auto nodeptr=it._nodeptr->next;
+            if(nodeptr==&other.head || pos._nodeptr==it._nodeptr || pos._nodeptr==nodeptr) return;
+            auto range=take_range(other,it._nodeptr,nodeptr,1);
+            link_after(pos._nodeptr,range.first,range.second,1);
+        }
+
+        // 把 other 中开区间 (first, last) 内的元素移到 pos 之后；pos 不能落在区间内。
+        // 需要走一遍区间找到末尾并计数，O(区间长度)
+        void splice_after(Iterator pos, SLinkedList& other, Iterator first, Iterator last){
+            if(first._nodeptr->next==last._nodeptr) return;
+            unsigned int count=1;
+            auto end=first._nodeptr->next;
+            while(end->next!=last._nodeptr){
+                end=end->next;
+                count++;
+            }
+            auto range=take_range(other,first._nodeptr,end,count);
+            link_after(pos._nodeptr,range.first,range.second,count);
+        }
+
+        // 两个链表都已按 comp 有序：把 other 归并进来，other 变空。
+        // 稳定（相等时本链表的元素在前），只改链接，不分配内存也不移动元素。
+        // 例外：两个 Slab 链表之间 other 的节点先要在本链表中重新分配、移动元素（O(other.size())，可能抛出），再归并
+        template<typename Compare=std::less<T>>
+        void merge(SLinkedList& other, Compare comp=Compare()){
+            if(&other==this || other.empty()) return;
+            unsigned int count=other._size;
+            auto range=take_range(other,&other.head,other.tail,count);
+            range.second->next=nullptr;
+            if(empty()){
+                head.next=range.first;
+                tail=range.second;
+            }else{
+                auto oldTail=tail;
+                oldTail->next=nullptr;
+                head.next=merge_chains(head.next,range.first,comp);
+                // 归并后的末尾一定是两条链末尾中较大的那个（相等时 other 的在后）
+                tail=comp(range.second->data,oldTail->data) ? oldTail : range.second;
+            }
+            tail->next=&head;
+            _size+=count;
+        }
+
+        // 自底向上归并排序：O(n log n)，稳定，只改链接，不分配内存也不移动元素。
+        // bins[i] 是长度为 2^i 的有序段，每取下一个节点就像二进制加一那样逐级向上归并
+        template<typename Compare=std::less<T>>
+        void sort(Compare comp=Compare()){
+            if(_size<2) return;
+            Node* bins[sizeof(_size)*8+1]={};
+            unsigned int used=0;
+            tail->next=nullptr;
+            auto nodeptr=head.next;
+            while(nodeptr!=nullptr){
+                auto carry=nodeptr;
+                nodeptr=nodeptr->next;
+                carry->next=nullptr;
+                unsigned int i=0;
+                for(;i<used && bins[i]!=nullptr;i++){
+                    carry=merge_chains(bins[i],carry,comp); // bins[i] 里的元素更早出现，放在前面保证稳定
+                    bins[i]=nullptr;
+                }
+                bins[i]=carry;
+                if(i==used) used++;
+            }
+            Node* result=nullptr;
+            for(unsigned int i=0;i<used;i++){
+                if(bins[i]!=nullptr)
+                    result = result==nullptr ? bins[i] : merge_chains(bins[i],result,comp);
+            }
+            head.next=result;
+            auto last=result;
+            while(last->next!=nullptr) last=last->next;
+            tail=last;
+            tail->next=&head;
+        }
+
+        void reverse(){
+            if(_size<2) return;
+            Node* prev=&head;
+            auto curr=head.next;
+            tail=curr;
+            while(curr!=&head){
+                auto next=curr->next;
+                curr->next=prev;
+                prev=curr;
+                curr=next;
+            }
+            head.next=prev;
+        }
+
+    private:
+        // 析构全部节点并回到空链表；拷贝/移动赋值也复用它（显式调用析构函数会连基类中的 slab 一起结束生命周期）
+        void destroy_nodes(){
+            if constexpr (is_slab<Allocator>::value && std::is_trivially_destructible<T>::value){
+                // 节点都在链表自己的块里，元素又无需析构：O(块数) 整块归还
+                head.next=&head;
+            }else{
+                for(auto it=&head;it->next!=&head;){
+                    auto nodeptr = it->next;
+                    it->next = nodeptr->next;
+                    nodeptr->data.~T();
+                    if constexpr (!is_slab<Allocator>::value)
+                        this->deallocate_node(nodeptr);
+                }
+            }
+            this->release_all_nodes();
+            _size=0;
+            tail=&head;
+        }
+
+        // 把已串好的 first..last（共 count 个节点）挂到 pos 之后
+        void link_after(Node* pos, Node* first, Node* last, unsigned int count){
+            last->next=pos->next;
+            pos->next=first;
+            if(pos==tail) tail=last;
+            _size+=count;
+        }
+
+        // 从 other 中摘下 beforeFirst 之后直到 last 的 count 个节点，交给本链表。
+        // 普通分配器的节点可以直接转交；Slab 链表的节点属于 other 自己的块，只能在本链表中重新分配并移动元素，O(count)。
+        // 后者先建好整条新链，全部成功后才从 other 摘下并释放旧节点：中途抛出异常时释放新链，other 不变
+        // （移动构造可能抛出时改为拷贝，见 std::move_if_noexcept）
+        std::pair<Node*,Node*> take_range(SLinkedList& other, Node* beforeFirst, Node* last, unsigned int count){
+            if constexpr (is_slab<Allocator>::value){
+                if(&other!=this){
+                    Node* chain=nullptr;
+                    Node** link=&chain;
+                    Node* newLast=nullptr;
+                    try{
+                        for(auto old=beforeFirst->next;;old=old->next){
+                            auto nodeptr=this->allocate_node();
+                            try{
+                                new (&nodeptr->data) T(std::move_if_noexcept(old->data));
+                            }catch(...){
+                                this->deallocate_node(nodeptr);
+                                throw;
+                            }
+                            *link=nodeptr;
+                            link=&nodeptr->next;
+                            newLast=nodeptr;
+                            if(old==last) break;
+                        }
+                    }catch(...){
+                        *link=nullptr;
+                        free_chain(chain);
+                        throw;
+                    }
+                    auto old=unlink_range(other,beforeFirst,last,count);
+                    for(unsigned int i=0;i<count;i++){
+                        auto next=old->next;
+                        old->data.~T();
+                        other.deallocate_node(old);
+                        old=next;
+                    }
+                    return {chain,newLast};
+                }
+            }
+            return {unlink_range(other,beforeFirst,last,count),last};
+        }
+
+        // 把 beforeFirst 之后直到 last 的 count 个节点从 other 中断开，返回第一个
+        static Node* unlink_range(SLinkedList& other, Node* beforeFirst, Node* last, unsigned int count){
+            auto first=beforeFirst->next;
+            beforeFirst->next=last->next;
+            if(other.tail==last) other.tail=beforeFirst;
+            other._size-=count;
+            return first;
+        }
+
+        // 析构并释放一条以 nullptr 结尾、还未挂进链表的节点链
+        void free_chain(Node* chain){
+            while(chain!=nullptr){
+                auto next=chain->next;
+                chain->data.~T();
+                this->deallocate_node(chain);
+                chain=next;
+            }
+        }
+
+        // 归并两条以 nullptr 结尾的有序链，相等时 a 的元素在前
+        template<typename Compare>
+        static Node* merge_chains(Node* a, Node* b, Compare& comp){
+            Node* first=nullptr;
+            Node** link=&first;
+            while(a!=nullptr && b!=nullptr){
+                if(comp(b->data,a->data)){
+                    *link=b;
+                    link=&b->next;
+                    b=b->next;
+                }else{
+                    *link=a;
+                    link=&a->next;
+                    a=a->next;
+                }
+            }
+            *link = a!=nullptr ? a : b;
+            return first;
+        }
+
         unsigned int _size;
         Node head;
         Node* tail;
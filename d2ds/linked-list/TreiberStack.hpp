@@ -0,0 +1,62 @@
+#ifndef TREIBER_STACK_HPP_D2DS
+#define TREIBER_STACK_HPP_D2DS
+
+#include <atomic>
+
+#include <common/common.hpp>
+#include <common/LinkStack.hpp>
+#include <linked-list/EmbeddedList.hpp>
+
+namespace d2ds {
+// show your code
+    // AtomicSinglyLink 与 LinkStack 在 common/LinkStack.hpp（PoolAllocator 的空闲栈也用它们），这里在其上加对象层
+
+    // 侵入式无锁栈：对象通过自己的 AtomicSinglyLink 成员入栈，栈本身不分配内存，例如
+    //     struct Buffer{ AtomicSinglyLink free_link; char data[4096]; };
+    //     IntrusiveStack<Buffer, &Buffer::free_link> free_buffers;
+    // 约束同 LinkStack：对象在栈的生命周期内不能被释放。
+    template<typename T, AtomicSinglyLink T::* Member>
+    class IntrusiveStack{
+    public:
+        static T* to_object(AtomicSinglyLink* link){
+            return link==nullptr ? nullptr : container_of(link,Member);
+        }
+
+        // pop_all 返回的链上 obj 的下一个对象，没有时返回 nullptr
+        static T* next(T* obj){
+            return to_object((obj->*Member).next.load(std::memory_order_relaxed));
+        }
+
+        void push(T& obj){
+            _stack.push(&(obj.*Member));
+        }
+
+        // first..last 需已用 link 串好（last 的 next 会被覆盖），
+        // 典型用法是把 pop_all 取出并处理过的整条链原样放回
+        void push_chain(T& first, T& last){
+            _stack.push_chain(&(first.*Member),&(last.*Member));
+        }
+
+        // 串好 first..last 的辅助函数：把 obj 挂到 prev 之后
+        static void link_after(T& prev, T& obj){
+            (prev.*Member).next.store(&(obj.*Member),std::memory_order_relaxed);
+        }
+
+        T* pop(){
+            return to_object(_stack.pop());
+        }
+
+        T* pop_all(){
+            return to_object(_stack.pop_all());
+        }
+
+        bool empty() const{
+            return _stack.empty();
+        }
+
+    private:
+        LinkStack _stack;
+    };
+}
+
+#endif
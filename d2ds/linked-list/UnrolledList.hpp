@@ -0,0 +1,393 @@
+#ifndef UNROLLED_LIST_HPP_D2DS
+#define UNROLLED_LIST_HPP_D2DS
+
+#include <common/common.hpp>
+
+namespace d2ds {
+// show your code
+
+    // 展开链表的节点：一个节点连续存放最多 K 个元素，遍历时每 K 个元素才跳一次指针
+    template<typename T, unsigned int K>
+    struct UnrolledListNode{
+        UnrolledListNode* prev;
+        UnrolledListNode* next;
+        unsigned int count;
+        alignas(T) unsigned char storage[sizeof(T)*K];
+
+        T* elems(){
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    // V 为 T 或 const T
+    template<typename T, unsigned int K, typename V>
+    struct UnrolledListIterator{
+        using Node=UnrolledListNode<T, K>;
+        UnrolledListIterator():_nodeptr{nullptr},_index{0}{}
+        UnrolledListIterator(Node* node, unsigned int index):_nodeptr{node},_index{index}{}
+        Node* _nodeptr;
+        unsigned int _index;
+
+        V& operator*() const{
+            return _nodeptr->elems()[_index];
+        }
+
+        V* operator->() const{
+            return _nodeptr->elems()+_index;
+        }
+
+        bool operator==(const UnrolledListIterator& other) const{
+            return _nodeptr==other._nodeptr && _index==other._index;
+        }
+
+        bool operator!=(const UnrolledListIterator& other) const{
+            return !(*this==other);
+        }
+
+        UnrolledListIterator& operator++(){
+            if(++_index==_nodeptr->count){
+                _nodeptr=_nodeptr->next;
+                _index=0;
+            }
+            return *this;
+        }
+
+        UnrolledListIterator operator++(int){
+            auto old=*this;
+            ++*this;
+            return old;
+        }
+    };
+
+    // 默认每个节点约 256 字节的元素
+    template<typename T>
+    constexpr unsigned int unrolled_default_k = sizeof(T) >= 64 ? 4 : 256 / sizeof(T);
+
+    // 展开链表（双向）：
+    //   - 下标访问、按下标插入/删除先按节点跳过 count 个元素，代价 O(n/K + K)；
+    //   - 插入时节点已满则对半分裂；删除后节点少于 K/2 个元素时与后继合并，放不下就从后继借一个，
+    //     因此除尾节点外每个节点至少半满；
+    //   - push_back / push_front 在首尾节点满时直接新开节点，顺序追加得到的节点都是满的。
+    // 节点较大（超过 PoolAllocator 的 512 字节上限时内存池也只是转交系统堆），默认用 DefaultAllocator。
+    template<typename T, unsigned int K = unrolled_default_k<T>, typename Allocator = DefaultAllocator>
+    class UnrolledList{
+        static_assert(K >= 2, "UnrolledList needs at least two elements per node");
+    public:
+        using Node = UnrolledListNode<T, K>;
+        using Iterator = UnrolledListIterator<T, K, T>;
+        using ConstIterator = UnrolledListIterator<T, K, const T>;
+
+        UnrolledList():_size{0},_nodes{0},head{nullptr},tail{nullptr}{}
+
+        UnrolledList(std::initializer_list<T> list):UnrolledList(){
+            for(auto& t : list){
+                push_back(t);
+            }
+        }
+
+        UnrolledList(const UnrolledList& other):UnrolledList(){
+            for(const T& t : other){
+                push_back(t);
+            }
+        }
+
+        UnrolledList& operator=(const UnrolledList& dsObj){
+            D2DS_SELF_ASSIGNMENT_CHECKER;
+            clear();
+            for(const T& t : dsObj){
+                push_back(t);
+            }
+            return *this;
+        }
+
+        UnrolledList(UnrolledList&& other):UnrolledList(){
+            take(other);
+        }
+
+        UnrolledList& operator=(UnrolledList&& dsObj){
+            D2DS_SELF_ASSIGNMENT_CHECKER;
+            clear();
+            take(dsObj);
+            return *this;
+        }
+
+        ~UnrolledList(){
+            clear();
+        }
+
+        unsigned int size() const{
+            return _size;
+        }
+
+        bool empty() const{
+            return _size==0;
+        }
+
+        // 当前节点数，用于观察填充率
+        unsigned int node_count() const{
+            return _nodes;
+        }
+
+        T& front(){
+            return head->elems()[0];
+        }
+
+        T& back(){
+            return tail->elems()[tail->count-1];
+        }
+
+        T& operator[](unsigned int index){
+            d2ds_assert(index<_size);
+            Node* node=locate(index);
+            return node->elems()[index];
+        }
+
+        void push_back(const T& t){
+            emplace_back(t);
+        }
+
+        void push_back(T&& t){
+            emplace_back(std::move(t));
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args){
+            if(tail==nullptr || tail->count==K)
+                link_after(tail,new_node());
+            T* slot=tail->elems()+tail->count;
+            new (slot) T(std::forward<Args>(args)...);
+            tail->count++;
+            _size++;
+            return *slot;
+        }
+
+        void push_front(const T& t){
+            T tmp(t); // t 可能引用本容器内的元素，后移元素之前先拷贝出来
+            if(head==nullptr || head->count==K)
+                link_after(nullptr,new_node());
+            insert_in_node(head,0,std::move(tmp));
+        }
+
+        void pop_back(){
+            d2ds_assert(_size>0);
+            tail->count--;
+            (tail->elems()+tail->count)->~T();
+            _size--;
+            if(tail->count==0)
+                unlink_and_free(tail);
+        }
+
+        void pop_front(){
+            d2ds_assert(_size>0);
+            erase_in_node(head,0);
+        }
+
+        // 在下标 index 处插入（index==size() 即追加）
+        void insert(unsigned int index, const T& t){
+            d2ds_assert(index<=_size);
+            if(index==_size){
+                push_back(t);
+                return;
+            }
+            T tmp(t); // 同 push_front：分裂或后移都可能搬走 t 引用的元素
+            Node* node=locate(index);
+            if(node->count==K){
+                split(node);
+                if(index>node->count){
+                    index-=node->count;
+                    node=node->next;
+                }
+            }
+            insert_in_node(node,index,std::move(tmp));
+        }
+
+        void erase(unsigned int index){
+            d2ds_assert(index<_size);
+            Node* node=locate(index);
+            erase_in_node(node,index);
+        }
+
+        void clear(){
+            for(Node* node=head;node!=nullptr;){
+                Node* next=node->next;
+                destroy(node->elems(),node->count);
+                Allocator::deallocate(node,sizeof(Node));
+                node=next;
+            }
+            head=tail=nullptr;
+            _size=0;
+            _nodes=0;
+        }
+
+        Iterator begin(){
+            return Iterator(head,0);
+        }
+
+        Iterator end(){
+            return Iterator();
+        }
+
+        ConstIterator begin() const{
+            return ConstIterator(head,0);
+        }
+
+        ConstIterator end() const{
+            return ConstIterator();
+        }
+
+        // 按节点批量访问：f(T* elems, unsigned int count)，内层是连续数组，编译器可以向量化
+        template<typename F>
+        void for_each_block(F f){
+            for(Node* node=head;node!=nullptr;node=node->next)
+                f(node->elems(),node->count);
+        }
+
+    private:
+        Node* new_node(){
+            Node* node=static_cast<Node*>(Allocator::allocate(sizeof(Node)));
+            node->prev=node->next=nullptr;
+            node->count=0;
+            return node;
+        }
+
+        // pos 为空时插到最前
+        void link_after(Node* pos, Node* node){
+            node->prev=pos;
+            node->next= pos==nullptr ? head : pos->next;
+            if(node->next!=nullptr) node->next->prev=node;
+            else tail=node;
+            if(pos!=nullptr) pos->next=node;
+            else head=node;
+            _nodes++;
+        }
+
+        // 节点中的元素需已析构或已搬走
+        void unlink_and_free(Node* node){
+            if(node->prev!=nullptr) node->prev->next=node->next;
+            else head=node->next;
+            if(node->next!=nullptr) node->next->prev=node->prev;
+            else tail=node->prev;
+            Allocator::deallocate(node,sizeof(Node));
+            _nodes--;
+        }
+
+        // 返回包含第 index 个元素的节点，index 改写为节点内下标；从离得近的一端开始找
+        Node* locate(unsigned int& index){
+            if(index<_size/2){
+                Node* node=head;
+                while(index>=node->count){
+                    index-=node->count;
+                    node=node->next;
+                }
+                return node;
+            }
+            unsigned int from_back=_size-index; // >=1
+            Node* node=tail;
+            while(from_back>node->count){
+                from_back-=node->count;
+                node=node->prev;
+            }
+            index=node->count-from_back;
+            return node;
+        }
+
+        // 要求 node 未满，t 不能引用本容器内的元素
+        void insert_in_node(Node* node, unsigned int index, T&& t){
+            T* elems=node->elems();
+            if(index<node->count)
+                open_gap(elems+index,node->count-index);
+            new (elems+index) T(std::move(t));
+            node->count++;
+            _size++;
+        }
+
+        void erase_in_node(Node* node, unsigned int index){
+            T* elems=node->elems();
+            (elems+index)->~T();
+            close_gap(elems+index,node->count-index-1);
+            node->count--;
+            _size--;
+            if(node->count==0){
+                unlink_and_free(node);
+            }else if(node->count<K/2 && node->next!=nullptr){
+                rebalance(node);
+            }
+        }
+
+        // 把 node 的后一半元素搬到新开的后继节点
+        void split(Node* node){
+            Node* right=new_node();
+            unsigned int keep=node->count/2;
+            relocate(node->elems()+keep,node->count-keep,right->elems());
+            right->count=node->count-keep;
+            node->count=keep;
+            link_after(node,right);
+        }
+
+        // node 不足半满：能和后继放进一个节点就合并，否则从后继借一个元素
+        void rebalance(Node* node){
+            Node* next=node->next;
+            if(node->count+next->count<=K){
+                relocate(next->elems(),next->count,node->elems()+node->count);
+                node->count+=next->count;
+                next->count=0;
+                unlink_and_free(next);
+            }else{
+                relocate(next->elems(),1,node->elems()+node->count);
+                node->count++;
+                close_gap(next->elems(),next->count-1);
+                next->count--;
+            }
+        }
+
+        // p[0..n) 整体后移一位，结束后 p[0] 为未构造的内存
+        static void open_gap(T* p, unsigned int n){
+            if constexpr (is_trivially_relocatable<T>::value){
+                std::memmove(static_cast<void*>(p+1),static_cast<const void*>(p),sizeof(T)*n);
+            }else{
+                new (p+n) T(std::move(p[n-1]));
+                for(unsigned int i=n-1;i>0;i--)
+                    p[i]=std::move(p[i-1]);
+                p->~T();
+            }
+        }
+
+        // p[0] 为未构造的内存，p[1..n] 整体前移一位，结束后 p[n] 为未构造的内存
+        static void close_gap(T* p, unsigned int n){
+            if(n==0) return;
+            if constexpr (is_trivially_relocatable<T>::value){
+                std::memmove(static_cast<void*>(p),static_cast<const void*>(p+1),sizeof(T)*n);
+            }else{
+                new (p) T(std::move(p[1]));
+                for(unsigned int i=1;i<n;i++)
+                    p[i]=std::move(p[i+1]);
+                (p+n)->~T();
+            }
+        }
+
+        static void destroy(T* p, unsigned int n){
+            if constexpr (!std::is_trivially_destructible<T>::value){
+                for(unsigned int i=0;i<n;i++)
+                    (p+i)->~T();
+            }
+        }
+
+        // 要求 *this 为空
+        void take(UnrolledList& other){
+            _size=other._size;
+            _nodes=other._nodes;
+            head=other.head;
+            tail=other.tail;
+            other._size=0;
+            other._nodes=0;
+            other.head=other.tail=nullptr;
+        }
+
+        unsigned int _size;
+        unsigned int _nodes;
+        Node* head;
+        Node* tail;
+    };
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <random>
+
+#include "tree/BTreeMap.hpp"
+
+using namespace d2ds;
+
+// BTreeMap 走 SIMD 定位的键类型：±inf、类型最大/最小值作为键时不能与空位填充混淆；
+// 再对整数/浮点键和 std::map 做随机的 insert / erase / find / lower_bound / upper_bound 对照
+
+template<typename K>
+static void TestExtremeKeys(K lo, K hi)
+{
+    BTreeMap<K, int> map;
+    map.insert(K(1), 1);
+    assert(map.insert(hi, 2).second);
+    assert(map.find(hi) != map.end() && map.find(hi).value() == 2);
+    assert(!map.insert(hi, 3).second && map.size() == 2);
+    assert(map.lower_bound(hi).key() == hi && map.upper_bound(hi) == map.end());
+    assert(map.insert(lo, 4).second && map.find(lo).value() == 4);
+    assert(map.lower_bound(lo).key() == lo);
+
+    // 多层树里每个节点都有空位
+    for (int i = 2; i < 5000; ++i) map.insert(K(i), i);
+    assert(map.height() > 1);
+    assert(map.find(hi) != map.end() && map.find(lo) != map.end());
+    assert(!map.insert(hi, 5).second && map.size() == 5001);
+    assert(map.erase(hi) == 1 && map.find(hi) == map.end() && map.size() == 5000);
+    assert(map.insert(hi, 6).second && map.find(hi).value() == 6);
+}
+
+template<typename K, typename Gen>
+static void Differential(Gen gen, int ops)
+{
+    std::mt19937 rng(7);
+    BTreeMap<K, int> map;
+    std::map<K, int> ref;
+    for (int i = 0; i < ops; ++i) {
+        K key = gen(rng);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            assert(map.insert(key, i).second == ref.emplace(key, i).second);
+            break;
+        case 2:
+            assert(map.erase(key) == ref.erase(key));
+            break;
+        default: {
+            auto lb = map.lower_bound(key);
+            auto rlb = ref.lower_bound(key);
+            assert((lb == map.end()) == (rlb == ref.end()));
+            if (rlb != ref.end()) assert(lb.key() == rlb->first && lb.value() == rlb->second);
+            auto ub = map.upper_bound(key);
+            auto rub = ref.upper_bound(key);
+            assert((ub == map.end()) == (rub == ref.end()));
+            if (rub != ref.end()) assert(ub.key() == rub->first);
+            assert((map.find(key) == map.end()) == (ref.find(key) == ref.end()));
+        }
+        }
+        assert(map.size() == ref.size());
+    }
+    auto it = map.begin();
+    for (const auto& kv : ref) {
+        assert(it.key() == kv.first && it.value() == kv.second);
+        ++it;
+    }
+    assert(it == map.end());
+}
+
+int main()
+{
+    TestExtremeKeys<int32_t>(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+    TestExtremeKeys<int64_t>(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+    TestExtremeKeys<double>(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+    TestExtremeKeys<double>(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max());
+    TestExtremeKeys<float>(-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
+
+    Differential<int16_t>([](std::mt19937& rng) { return int16_t(rng()); }, 200000);
+    Differential<int32_t>([](std::mt19937& rng) { return int32_t(rng() % 20000) - 10000; }, 200000);
+    Differential<double>(
+        [](std::mt19937& rng) {
+            unsigned r = rng() % 1002;
+            if (r == 1000) return std::numeric_limits<double>::infinity();
+            if (r == 1001) return -std::numeric_limits<double>::infinity();
+            return double(r) / 4;
+        },
+        200000);
+    printf("BTreeMapTest passed\n");
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. tests/BTreeMapTest.cpp -o btree_map_test
+*/
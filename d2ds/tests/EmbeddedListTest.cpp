@@ -0,0 +1,221 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "linked-list/EmbeddedList.hpp"
+
+using namespace d2ds;
+
+// IntrusiveSList / IntrusiveList：增删、O(n) remove、各个 splice、链表移动、对象拷贝、
+// 以及一个对象通过不同的链接成员同时挂在多条链表上
+
+struct Item
+{
+    int id;
+    SinglyLink free_link;
+    SinglyLink batch_link;
+    DoublyLink lru_link;
+    DoublyLink timer_link;
+
+    explicit Item(int i) : id(i) {}
+};
+
+using SList = IntrusiveSList<Item, &Item::free_link>;
+using BatchList = IntrusiveSList<Item, &Item::batch_link>;
+using List = IntrusiveList<Item, &Item::lru_link>;
+using TimerList = IntrusiveList<Item, &Item::timer_link>;
+
+template<typename L>
+static std::vector<int> Ids(L& list)
+{
+    std::vector<int> ids;
+    for (auto it = list.begin(); it != list.end(); ++it) ids.push_back(it->id);
+    return ids;
+}
+
+static void TestSList(std::vector<Item>& items)
+{
+    SList list;
+    assert(list.empty() && list.size() == 0);
+    list.push_back(items[1]);
+    list.push_front(items[0]);
+    list.push_back(items[2]);
+    assert((Ids(list) == std::vector<int>{0, 1, 2}));
+    assert(&list.front() == &items[0] && &list.back() == &items[2]);
+    assert(SList::is_linked(items[1]) && !SList::is_linked(items[3]));
+
+    assert(&list.pop_front() == &items[0] && !SList::is_linked(items[0]));
+    list.insert_after(list.begin(), items[3]); // 1 3 2
+    assert((Ids(list) == std::vector<int>{1, 3, 2}));
+
+    // remove：中间、表尾、不在表上
+    assert(list.remove(items[3]) && !SList::is_linked(items[3]));
+    assert(list.remove(items[2]) && &list.back() == &items[1]);
+    assert(!list.remove(items[5]));
+    list.push_back(items[2]); // 表尾更新正确才能接在 1 后面
+    assert((Ids(list) == std::vector<int>{1, 2}));
+
+    // splice_back / splice_after
+    SList other;
+    other.push_back(items[3]);
+    other.push_back(items[4]);
+    list.splice_back(other);
+    assert(other.empty() && (Ids(list) == std::vector<int>{1, 2, 3, 4}) && &list.back() == &items[4]);
+    other.push_back(items[5]);
+    other.push_back(items[6]);
+    list.splice_after(list.begin(), other); // 插到 1 之后
+    assert(other.empty() && (Ids(list) == std::vector<int>{1, 5, 6, 2, 3, 4}));
+    other.push_back(items[7]);
+    auto last = list.begin();
+    for (auto it = list.begin(); it != list.end(); ++it) last = it;
+    list.splice_after(last, other); // 插到表尾之后，表尾要跟着更新
+    list.push_back(items[8]);
+    assert((Ids(list) == std::vector<int>{1, 5, 6, 2, 3, 4, 7, 8}));
+    list.splice_back(list); // 自己拼自己是空操作
+    assert(list.size() == 8);
+
+    // 移动构造 / 移动赋值
+    SList moved(std::move(list));
+    assert(list.empty() && moved.size() == 8 && &moved.back() == &items[8]);
+    SList assigned;
+    assigned.push_back(items[0]);
+    assigned = std::move(moved);
+    assert(moved.empty() && !SList::is_linked(items[0]) && (Ids(assigned) == std::vector<int>{1, 5, 6, 2, 3, 4, 7, 8}));
+    moved.push_back(items[0]); // 被移走的链表仍然可用
+    assert(moved.size() == 1);
+
+    // 拷贝对象不拷贝链接
+    Item copy = items[1];
+    assert(!SList::is_linked(copy) && SList::is_linked(items[1]));
+    copy = items[5];
+    assert(!SList::is_linked(copy));
+    moved.push_back(copy);
+    assert(moved.size() == 2 && assigned.size() == 8);
+    moved.clear();
+
+    assigned.clear();
+    for (Item& item : items) assert(!SList::is_linked(item));
+}
+
+static void TestList(std::vector<Item>& items)
+{
+    List list;
+    for (int i = 0; i < 4; ++i) list.push_back(items[i]);
+    list.push_front(items[4]); // 4 0 1 2 3
+    assert((Ids(list) == std::vector<int>{4, 0, 1, 2, 3}));
+    assert(&list.pop_back() == &items[3] && &list.pop_front() == &items[4]);
+    List::unlink(items[1]); // O(1) 摘除
+    assert((Ids(list) == std::vector<int>{0, 2}) && !List::is_linked(items[1]));
+    auto it = list.insert(List::iterator_to(items[2]), items[1]);
+    assert(&*it == &items[1] && (Ids(list) == std::vector<int>{0, 1, 2}));
+    it = list.erase(it);
+    assert(&*it == &items[2]);
+    list.erase(items[0]);
+    assert((Ids(list) == std::vector<int>{2}));
+
+    // splice(pos, other)：整条链表
+    List other;
+    for (int i = 5; i < 9; ++i) other.push_back(items[i]);
+    list.splice(list.begin(), other);
+    assert(other.empty() && (Ids(list) == std::vector<int>{5, 6, 7, 8, 2}));
+
+    // splice(pos, other, it)：单个元素，来自另一条链表或本表
+    other.push_back(items[0]);
+    other.push_back(items[1]);
+    list.splice(list.end(), other, other.begin());
+    assert((Ids(list) == std::vector<int>{5, 6, 7, 8, 2, 0}) && (Ids(other) == std::vector<int>{1}));
+    list.splice(list.begin(), list, List::iterator_to(items[2]));
+    assert((Ids(list) == std::vector<int>{2, 5, 6, 7, 8, 0}));
+    list.splice(List::iterator_to(items[5]), list, List::iterator_to(items[2])); // 原地不动
+    assert((Ids(list) == std::vector<int>{2, 5, 6, 7, 8, 0}));
+
+    // splice(pos, other, first, last)：一段
+    list.splice(other.end(), list, List::iterator_to(items[6]), List::iterator_to(items[0]));
+    assert((Ids(list) == std::vector<int>{2, 5, 0}) && (Ids(other) == std::vector<int>{1, 6, 7, 8}));
+    list.splice(list.end(), other, other.begin(), other.begin());
+    assert(other.size() == 4);
+
+    // 反向遍历与 const 迭代器
+    std::vector<int> back;
+    for (auto r = other.end(); r != other.begin();) back.push_back((--r)->id);
+    assert((back == std::vector<int>{8, 7, 6, 1}));
+    const List& cref = other;
+    int sum = 0;
+    for (const Item& item : cref) sum += item.id;
+    assert(sum == 22 && cref.front().id == 1 && cref.back().id == 8);
+
+    // 移动
+    List moved(std::move(other));
+    assert(other.empty() && (Ids(moved) == std::vector<int>{1, 6, 7, 8}));
+    list = std::move(moved);
+    assert(moved.empty() && !List::is_linked(items[2]) && (Ids(list) == std::vector<int>{1, 6, 7, 8}));
+
+    // 拷贝对象不拷贝链接
+    Item copy = items[6];
+    assert(!List::is_linked(copy));
+    list.push_back(copy);
+    assert(list.size() == 5);
+    List::unlink(copy);
+    list.clear();
+    for (Item& item : items) assert(!List::is_linked(item));
+}
+
+static void TestMultipleLists(std::vector<Item>& items)
+{
+    SList free_list;
+    BatchList batch;
+    List lru;
+    TimerList timers;
+    for (int i = 0; i < 6; ++i)
+    {
+        free_list.push_back(items[i]);
+        lru.push_front(items[i]);
+        if (i % 2 == 0) batch.push_back(items[i]);
+        if (i % 3 == 0) timers.push_back(items[i]);
+    }
+    assert((Ids(free_list) == std::vector<int>{0, 1, 2, 3, 4, 5}));
+    assert((Ids(batch) == std::vector<int>{0, 2, 4}));
+    assert((Ids(lru) == std::vector<int>{5, 4, 3, 2, 1, 0}));
+    assert((Ids(timers) == std::vector<int>{0, 3}));
+
+    // 从一条链表摘下不影响其他链表
+    List::unlink(items[3]);
+    assert(free_list.remove(items[2]));
+    assert((Ids(free_list) == std::vector<int>{0, 1, 3, 4, 5}));
+    assert((Ids(batch) == std::vector<int>{0, 2, 4}));
+    assert((Ids(lru) == std::vector<int>{5, 4, 2, 1, 0}));
+    assert((Ids(timers) == std::vector<int>{0, 3}));
+
+    batch.clear();
+    timers.clear();
+    assert(free_list.size() == 5 && lru.size() == 5);
+    free_list.clear();
+    lru.clear();
+}
+
+static void TestContainerOf(Item& item)
+{
+    assert(member_offset(&Item::free_link) == offsetof(Item, free_link));
+    assert(member_offset(&Item::timer_link) == offsetof(Item, timer_link));
+    assert(container_of(&item.batch_link, &Item::batch_link) == &item);
+    const Item& citem = item;
+    assert(container_of(&citem.lru_link, &Item::lru_link) == &item);
+}
+
+int main()
+{
+    std::vector<Item> items;
+    for (int i = 0; i < 10; ++i) items.emplace_back(i);
+    TestContainerOf(items[0]);
+    TestSList(items);
+    TestList(items);
+    TestMultipleLists(items);
+    printf("EmbeddedListTest passed\n");
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. tests/EmbeddedListTest.cpp -o embedded_list_test
+*/
@@ -0,0 +1,53 @@
+#include <cassert>
+#include <climits>
+#include <cstdio>
+#include <vector>
+
+#include "algorithm/Parallel.hpp"
+
+using namespace d2ds;
+
+// parallel::reduce 的累加类型：init 比元素类型宽时必须在 init 的类型里累加（与 std::reduce 一致），
+// 只有同类型求和才走 simd::sum
+
+static void TestWideningReduce(ThreadPool& pool)
+{
+    std::vector<int> ints(1000000, INT_MAX / 2);
+    long long expect = (long long)(INT_MAX / 2) * 1000000;
+    assert(parallel::reduce(pool, ints.data(), ints.data() + ints.size(), 0LL) == expect);
+    assert(parallel::reduce(pool, ints.data(), ints.data() + ints.size(), 0LL, std::plus<>()) == expect);
+
+    std::vector<unsigned char> bytes(100000, 200);
+    assert(parallel::reduce(pool, bytes.data(), bytes.data() + bytes.size(), 0L) == 20000000L);
+
+    // 2^24 之后 float 再加 1 不变，double 仍然精确
+    std::vector<float> floats(20000000, 1.0f);
+    assert(parallel::reduce(pool, floats.data(), floats.data() + floats.size(), 0.0) == 20000000.0);
+}
+
+static void TestSameTypeReduce(ThreadPool& pool)
+{
+    std::vector<int> ints(300000);
+    long long expect = 0;
+    for (size_t i = 0; i < ints.size(); ++i)
+    {
+        ints[i] = int(i % 1000) - 500;
+        expect += ints[i];
+    }
+    assert(parallel::reduce(pool, ints.data(), ints.data() + ints.size(), 0) == int(expect));
+    assert(parallel::reduce(pool, ints.begin(), ints.end(), 0LL) == expect);
+    assert(parallel::reduce(pool, ints.data(), ints.data(), 7) == 7);
+}
+
+int main()
+{
+    ThreadPool pool(3);
+    TestWideningReduce(pool);
+    TestSameTypeReduce(pool);
+    printf("ParallelTest passed\n");
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. tests/ParallelTest.cpp -o parallel_test
+*/
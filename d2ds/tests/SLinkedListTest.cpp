@@ -0,0 +1,187 @@
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "linked-list/SLinkedList.hpp"
+
+using namespace d2ds;
+
+// SLinkedList 的 tail 不变式：erase_after 删掉表尾之后，依赖 tail 的 push_back / splice_after / merge / sort
+// 必须仍然正确；普通分配器与 Slab<> 两种节点存储都测。
+// 以及两个 Slab 链表之间 splice / merge 时元素构造抛出异常：两个链表都保持原样，不泄漏节点与元素
+
+template<typename L>
+static std::vector<int> Values(L& list)
+{
+    std::vector<int> values;
+    for (auto it = list.begin(); it != list.end(); ++it) values.push_back(*it);
+    assert(values.size() == list.size());
+    return values;
+}
+
+// {3, 1, 2} 删掉表尾 2，剩 {3, 1}
+template<typename L>
+static void EraseLast(L& list)
+{
+    auto it = list.begin();
+    ++it;
+    list.erase_after(it);
+    assert(list.size() == 2 && list.back() == 1);
+}
+
+template<typename Allocator>
+static void TestEraseThenUseTail()
+{
+    using L = SLinkedList<int, Allocator>;
+    {
+        L a{3, 1, 2};
+        EraseLast(a);
+        a.sort();
+        assert((Values(a) == std::vector<int>{1, 3}) && a.back() == 3);
+        a.push_back(4);
+        assert((Values(a) == std::vector<int>{1, 3, 4}));
+    }
+    {
+        L a{3, 1, 2}, b{5, 0};
+        EraseLast(a);
+        a.splice_after(a.before_begin(), b);
+        assert(b.empty() && (Values(a) == std::vector<int>{5, 0, 3, 1}));
+        a.sort();
+        assert((Values(a) == std::vector<int>{0, 1, 3, 5}) && a.back() == 5);
+    }
+    {
+        // splice 到表尾之后：新元素要成为表尾
+        L a{3, 1, 2}, b{7};
+        EraseLast(a);
+        auto last = a.begin();
+        ++last;
+        a.splice_after(last, b);
+        assert((Values(a) == std::vector<int>{3, 1, 7}) && a.back() == 7);
+    }
+    {
+        L a{1, 4, 9}, b{2, 5};
+        auto it = a.begin();
+        ++it;
+        a.erase_after(it); // {1, 4}
+        a.merge(b);
+        assert(b.empty() && (Values(a) == std::vector<int>{1, 2, 4, 5}) && a.back() == 5);
+        a.push_back(6);
+        assert((Values(a) == std::vector<int>{1, 2, 4, 5, 6}));
+    }
+    {
+        // other 的表尾被删后再整体移走
+        L a{8}, b{1, 2};
+        auto it = b.begin();
+        b.erase_after(it);
+        a.merge(b);
+        assert(b.empty() && (Values(a) == std::vector<int>{1, 8}));
+        b.push_back(3);
+        assert((Values(b) == std::vector<int>{3}));
+    }
+    {
+        // 删空再用
+        L a{1};
+        auto it = a.before_begin();
+        a.erase_after(it);
+        assert(a.empty());
+        a.push_back(2);
+        a.push_back(1);
+        a.sort();
+        assert((Values(a) == std::vector<int>{1, 2}));
+    }
+    {
+        // 什么都没删：tail 保持不变
+        L a{3, 1, 2};
+        auto it = a.begin();
+        ++it;
+        ++it;
+        a.erase_after(it);
+        assert(a.size() == 3 && a.back() == 2);
+        a.push_back(0);
+        a.sort();
+        assert((Values(a) == std::vector<int>{0, 1, 2, 3}));
+    }
+}
+
+// 第 throw_after 次拷贝时抛出；移动构造可能抛出，move_if_noexcept 会改用拷贝
+struct Thrower
+{
+    static int throw_after;
+    static int live;
+    int value;
+
+    Thrower(int v = 0) : value(v) { live++; }
+    Thrower(const Thrower& other) : value(other.value)
+    {
+        if (throw_after >= 0 && throw_after-- == 0) throw std::runtime_error("copy");
+        live++;
+    }
+    Thrower(Thrower&& other) noexcept(false) : Thrower(static_cast<const Thrower&>(other)) {}
+    Thrower& operator=(const Thrower&) = default;
+    ~Thrower() { live--; }
+    bool operator<(const Thrower& other) const { return value < other.value; }
+};
+int Thrower::throw_after = -1;
+int Thrower::live = 0;
+
+template<typename L>
+static std::vector<int> ThrowerValues(L& list)
+{
+    std::vector<int> values;
+    for (auto it = list.begin(); it != list.end(); ++it) values.push_back(it->value);
+    assert(values.size() == list.size());
+    return values;
+}
+
+static void TestSlabTransferThrows()
+{
+    using L = SLinkedList<Thrower, Slab<>>;
+    {
+        L a{1, 3}, b{2, 4, 6}; // 每个链表的哨兵节点里也有一个 T
+        Thrower::throw_after = 2;
+        bool thrown = false;
+        try {
+            a.splice_after(a.before_begin(), b);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        Thrower::throw_after = -1;
+        assert(thrown);
+        assert((ThrowerValues(a) == std::vector<int>{1, 3}) && (ThrowerValues(b) == std::vector<int>{2, 4, 6}));
+        assert(Thrower::live == 5 + 2);
+
+        Thrower::throw_after = 1;
+        thrown = false;
+        try {
+            a.merge(b);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        Thrower::throw_after = -1;
+        assert(thrown);
+        assert((ThrowerValues(a) == std::vector<int>{1, 3}) && (ThrowerValues(b) == std::vector<int>{2, 4, 6}));
+        assert(Thrower::live == 5 + 2);
+
+        // 失败之后两个链表仍然可用
+        a.merge(b);
+        assert(b.empty() && (ThrowerValues(a) == std::vector<int>{1, 2, 3, 4, 6}));
+        assert(Thrower::live == 5 + 2);
+        b.push_back(0);
+        assert(ThrowerValues(b) == std::vector<int>{0});
+    }
+    assert(Thrower::live == 0);
+}
+
+int main()
+{
+    TestEraseThenUseTail<PoolAllocator>();
+    TestEraseThenUseTail<Slab<>>();
+    TestSlabTransferThrows();
+    printf("SLinkedListTest passed\n");
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. tests/SLinkedListTest.cpp ../MemoryPool/v1/step3/src/MemoryPool.cpp -o slinked_list_test
+*/
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "array/StaticSearch.hpp"
+
+using namespace d2ds;
+
+// EytzingerArray / StaticBTree 与 std::lower_bound 对照：各种大小（含空、不满的最后一层/块）、重复键、
+// 类型最大/最小值与 ±inf 作为键或查询
+
+template<typename T>
+static void Check(const std::vector<T>& sorted, const std::vector<T>& queries)
+{
+    unsigned int n = unsigned(sorted.size());
+    EytzingerArray<T> eytzinger(sorted.data(), n);
+    StaticBTree<T> btree(sorted.data(), n);
+    std::vector<unsigned int> batch(queries.size());
+    eytzinger.lower_bound_batch(queries.data(), batch.data(), queries.size());
+    for (size_t j = 0; j < queries.size(); ++j) {
+        T q = queries[j];
+        unsigned int expect = unsigned(std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin());
+        unsigned int found = expect < n && sorted[expect] == q ? expect : EytzingerArray<T>::npos;
+        assert(eytzinger.lower_bound(q) == expect && batch[j] == expect && eytzinger.find(q) == found);
+        assert(btree.lower_bound(q) == expect && btree.find(q) == found);
+    }
+}
+
+static void TestInt32()
+{
+    std::mt19937 rng(1);
+    const int32_t lo = std::numeric_limits<int32_t>::min(), hi = std::numeric_limits<int32_t>::max();
+    for (unsigned int n : {0u, 1u, 2u, 3u, 7u, 15u, 16u, 17u, 31u, 100u, 1000u, 4095u, 65537u}) {
+        std::vector<int32_t> sorted(n);
+        for (auto& k : sorted) k = int32_t(rng() % (2 * n + 1)) - int32_t(n); // 有重复
+        if (n > 2) {
+            sorted[0] = lo;
+            sorted[1] = hi;
+        }
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<int32_t> queries = {lo, hi, lo + 1, hi - 1, 0};
+        for (int i = 0; i < 2000; ++i) queries.push_back(int32_t(rng() % (2 * n + 3)) - int32_t(n + 1));
+        Check(sorted, queries);
+    }
+}
+
+template<typename T>
+static void TestFloating()
+{
+    const T inf = std::numeric_limits<T>::infinity(), mx = std::numeric_limits<T>::max();
+    Check<T>({1, 2, inf}, {0, 1, 2, 3, mx, inf, -inf});
+    Check<T>({-inf, 1, mx}, {-inf, 0, 1, mx, inf});
+    Check<T>({-inf, -inf, inf, inf}, {-inf, 0, inf});
+    for (unsigned int n : {15u, 16u, 17u, 100u, 1000u}) {
+        std::vector<T> sorted;
+        for (unsigned int i = 0; i + 2 < n; ++i) sorted.push_back(T(i) / 2);
+        sorted.push_back(mx);
+        sorted.push_back(inf);
+        std::vector<T> queries = {-inf, T(0.25), T(n) / 4, mx, inf};
+        Check(sorted, queries);
+    }
+}
+
+int main()
+{
+    TestInt32();
+    TestFloating<float>();
+    TestFloating<double>();
+    printf("StaticSearchTest passed\n");
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -I. tests/StaticSearchTest.cpp -o static_search_test
+*/
@@ -0,0 +1,130 @@
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "linked-list/TreiberStack.hpp"
+
+using namespace d2ds;
+
+// LinkStack / IntrusiveStack 的压力测试：少量节点在多个线程之间反复 pop / push / pop_all / push_chain，
+// 节点被反复弹出又压回，正是 ABA 最容易出现的用法。每个节点带一个“被持有”标记，
+// 弹出时必须从 0 改成 1：同一个节点同时被两个线程拿到就会失败。结束后所有节点必须各出现一次。
+
+struct Node
+{
+    AtomicSinglyLink link;
+    std::atomic<int> held{0};
+    unsigned int id = 0;
+};
+
+using Stack = IntrusiveStack<Node, &Node::link>;
+
+static std::atomic<unsigned int> g_errors{0};
+
+static void Claim(Node* node)
+{
+    if (node->held.exchange(1, std::memory_order_relaxed) != 0) g_errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void Release(Node* node)
+{
+    node->held.store(0, std::memory_order_relaxed);
+}
+
+static void TestSingleThread()
+{
+    Node nodes[4];
+    Stack stack;
+    assert(stack.empty() && stack.pop() == nullptr && stack.pop_all() == nullptr);
+    for (Node& n : nodes) stack.push(n);
+    assert(stack.pop() == &nodes[3]);
+    Node* chain = stack.pop_all();
+    assert(chain == &nodes[2] && Stack::next(chain) == &nodes[1] && Stack::next(&nodes[1]) == &nodes[0]);
+    assert(Stack::next(&nodes[0]) == nullptr && stack.empty());
+    Stack::link_after(nodes[3], nodes[2]);
+    stack.push_chain(nodes[3], nodes[2]);
+    stack.push(nodes[0]);
+    assert(stack.pop() == &nodes[0] && stack.pop() == &nodes[3] && stack.pop() == &nodes[2] && stack.pop() == nullptr);
+}
+
+static void TestStress(unsigned int threads, unsigned int nodes_count, unsigned int iterations)
+{
+    std::vector<Node> nodes(nodes_count);
+    Stack stack;
+    for (unsigned int i = 0; i < nodes_count; ++i)
+    {
+        nodes[i].id = i;
+        stack.push(nodes[i]);
+    }
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&stack, iterations, t] {
+            std::vector<Node*> local;
+            for (unsigned int i = 0; i < iterations; ++i)
+            {
+                if ((i + t) % 16 == 0)
+                {
+                    // 取走整个栈，逐个认领后按原顺序串回去一次性压回
+                    Node* first = stack.pop_all();
+                    Node* last = nullptr;
+                    for (Node* n = first; n != nullptr; n = Stack::next(n))
+                    {
+                        Claim(n);
+                        last = n;
+                    }
+                    for (Node* n = first; n != nullptr; n = Stack::next(n)) Release(n);
+                    if (first != nullptr) stack.push_chain(*first, *last);
+                }
+                else if (Node* n = stack.pop())
+                {
+                    Claim(n);
+                    local.push_back(n);
+                }
+                // 手里最多攒 3 个，攒满了或者随机地还回去
+                if (local.size() >= 3 || (i % 5 == 0 && !local.empty()))
+                {
+                    Node* n = local.back();
+                    local.pop_back();
+                    Release(n);
+                    stack.push(*n);
+                }
+            }
+            for (Node* n : local)
+            {
+                Release(n);
+                stack.push(*n);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<unsigned int> seen(nodes_count, 0);
+    unsigned int total = 0;
+    for (Node* n = stack.pop_all(); n != nullptr; n = Stack::next(n))
+    {
+        seen[n->id]++;
+        total++;
+    }
+    assert(g_errors.load() == 0);
+    assert(total == nodes_count);
+    for (unsigned int c : seen) assert(c == 1);
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = argc > 1 ? unsigned(atoi(argv[1])) : 1000000;
+    TestSingleThread();
+    TestStress(4, 8, iterations);
+    TestStress(8, 64, iterations / 2);
+    printf("TreiberStackTest passed\n");
+    return 0;
+}
+
+/*
+g++ -O2 -std=c++17 -pthread -I. tests/TreiberStackTest.cpp -o treiber_stack_test
+*/
@@ -0,0 +1,551 @@
+#ifndef BTREE_MAP_HPP_D2DS
+#define BTREE_MAP_HPP_D2DS
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+#include "common/common.hpp"
+#include "common/simd.hpp"
+
+namespace d2ds {
+// show your code
+
+namespace detail {
+
+    // 节点内的键数组占 kBTreeKeyBytes 字节（两条缓存行，相邻行预取会一起带进来）
+    constexpr size_t kBTreeKeyBytes = 2 * CACHE_LINE_SIZE;
+
+    template<typename K, typename Compare>
+    struct btree_use_simd
+        : std::integral_constant<bool, simd::has_rank<K>::value && std::is_same<Compare, std::less<K>>::value> {};
+
+} // namespace detail
+
+// 缓存行大小的 B+ 树（有序 map，键唯一）：
+//   - 内部节点只存分隔键和孩子指针，键数组恰好占两条缓存行，扇出大、树矮；
+//   - 元素只在叶子里，叶子之间双向链接，有序遍历和区间扫描是顺序访问叶子；
+//   - 整数/浮点键且使用 std::less 时，节点内定位用 SIMD 一次比较整个键数组（无分支计数），
+//     其他情况在节点内二分查找；
+//   - 插入满节点时分裂，删除后不足半满时向兄弟借一个元素或与兄弟合并，保证 O(log n)。
+// 键和值存放在节点内的定长数组中，K、V 需要可默认构造、可移动赋值；插入/删除会移动元素，迭代器随之失效。
+template<typename K, typename V, typename Compare = std::less<K>, typename Allocator = DefaultAllocator>
+class BTreeMap {
+    static constexpr bool kSimd = detail::btree_use_simd<K, Compare>::value;
+
+public:
+    // 每个节点最多容纳的键数
+    static constexpr unsigned int kMaxKeys =
+        detail::kBTreeKeyBytes / sizeof(K) >= 4 ? unsigned(detail::kBTreeKeyBytes / sizeof(K)) : 4;
+
+private:
+    struct Node {
+        bool leaf;
+        unsigned int count;
+        alignas(CACHE_LINE_SIZE) K keys[kMaxKeys];
+
+        explicit Node(bool is_leaf) : leaf(is_leaf), count(0) {
+            if constexpr (kSimd)
+                std::fill(keys, keys + kMaxKeys, simd::rank_padding<K>());
+        }
+    };
+
+    struct Inner : Node {
+        Node* children[kMaxKeys + 1];
+        Inner() : Node(false) {}
+    };
+
+    struct Leaf : Node {
+        V values[kMaxKeys];
+        Leaf* prev = nullptr;
+        Leaf* next = nullptr;
+        Leaf() : Node(true) {}
+    };
+
+public:
+    template<bool Const>
+    class IteratorBase {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::pair<const K, V>;
+        using reference = std::pair<const K&, typename std::conditional<Const, const V&, V&>::type>;
+
+        IteratorBase() : _leaf(nullptr), _index(0) {}
+        template<bool C = Const, typename = typename std::enable_if<C>::type>
+        IteratorBase(const IteratorBase<false>& it) : _leaf(it._leaf), _index(it._index) {}
+
+        // 键和值分开存放，没有现成的 pair 可以引用，解引用返回 (键引用, 值引用)
+        reference operator*() const { return reference(key(), value()); }
+        const K& key() const { return _leaf->keys[_index]; }
+        typename std::conditional<Const, const V&, V&>::type value() const { return _leaf->values[_index]; }
+
+        IteratorBase& operator++() {
+            if (++_index == _leaf->count && _leaf->next != nullptr) {
+                _leaf = _leaf->next;
+                _index = 0;
+            }
+            return *this;
+        }
+
+        IteratorBase operator++(int) {
+            IteratorBase old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const IteratorBase& it) const { return _leaf == it._leaf && _index == it._index; }
+        bool operator!=(const IteratorBase& it) const { return !(*this == it); }
+
+    private:
+        friend class BTreeMap;
+        template<bool> friend class IteratorBase;
+        IteratorBase(Leaf* leaf, unsigned int index) : _leaf(leaf), _index(index) {}
+
+        // 停在某个叶子末尾时跳到下一个叶子开头；最后一个叶子的末尾就是 end()
+        IteratorBase& normalize() {
+            if (_leaf != nullptr && _index == _leaf->count && _leaf->next != nullptr) {
+                _leaf = _leaf->next;
+                _index = 0;
+            }
+            return *this;
+        }
+
+        Leaf* _leaf;
+        unsigned int _index;
+    };
+
+    using iterator = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    BTreeMap() = default;
+
+    BTreeMap(std::initializer_list<std::pair<K, V>> list) {
+        for (const auto& kv : list)
+            insert(kv.first, kv.second);
+    }
+
+    BTreeMap(const BTreeMap& other) {
+        for (auto it = other.begin(); it != other.end(); ++it)
+            insert(it.key(), it.value());
+    }
+
+    BTreeMap& operator=(const BTreeMap& dsObj) {
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        clear();
+        for (auto it = dsObj.begin(); it != dsObj.end(); ++it)
+            insert(it.key(), it.value());
+        return *this;
+    }
+
+    BTreeMap(BTreeMap&& other) { take(other); }
+
+    BTreeMap& operator=(BTreeMap&& dsObj) {
+        D2DS_SELF_ASSIGNMENT_CHECKER;
+        clear();
+        take(dsObj);
+        return *this;
+    }
+
+    ~BTreeMap() { clear(); }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    // 叶子在第 height() 层；空树为 0
+    unsigned int height() const {
+        unsigned int h = 0;
+        for (const Node* node = _root; node != nullptr; node = node->leaf ? nullptr : as_inner(node)->children[0])
+            h++;
+        return h;
+    }
+
+    iterator begin() { return iterator(_first, 0); }
+    iterator end() { return _last == nullptr ? iterator() : iterator(_last, _last->count); }
+    const_iterator begin() const { return const_cast<BTreeMap*>(this)->begin(); }
+    const_iterator end() const { return const_cast<BTreeMap*>(this)->end(); }
+
+    // 第一个键 >= key 的位置
+    iterator lower_bound(const K& key) {
+        if (_root == nullptr) return end();
+        Leaf* leaf = find_leaf(key);
+        return iterator(leaf, rank<false>(leaf, key)).normalize();
+    }
+
+    // 第一个键 > key 的位置
+    iterator upper_bound(const K& key) {
+        if (_root == nullptr) return end();
+        Leaf* leaf = find_leaf(key);
+        return iterator(leaf, rank<true>(leaf, key)).normalize();
+    }
+
+    const_iterator lower_bound(const K& key) const { return const_cast<BTreeMap*>(this)->lower_bound(key); }
+    const_iterator upper_bound(const K& key) const { return const_cast<BTreeMap*>(this)->upper_bound(key); }
+
+    iterator find(const K& key) {
+        if (_root == nullptr) return end();
+        Leaf* leaf = find_leaf(key);
+        unsigned int i = rank<false>(leaf, key);
+        return i < leaf->count && !_less(key, leaf->keys[i]) ? iterator(leaf, i) : end();
+    }
+
+    const_iterator find(const K& key) const { return const_cast<BTreeMap*>(this)->find(key); }
+
+    bool contains(const K& key) const { return find(key) != end(); }
+
+    V& at(const K& key) {
+        iterator it = find(key);
+        d2ds_assert(it != end());
+        return it.value();
+    }
+
+    const V& at(const K& key) const { return const_cast<BTreeMap*>(this)->at(key); }
+
+    V& operator[](const K& key) { return insert(key, V()).first.value(); }
+
+    // 键已存在时不修改，返回 (该元素, false)
+    std::pair<iterator, bool> insert(const K& key, const V& value) {
+        if (_root == nullptr) {
+            Leaf* leaf = new_node<Leaf>();
+            _root = leaf;
+            _first = _last = leaf;
+        }
+        Split split;
+        std::pair<iterator, bool> res = insert_rec(_root, key, value, split);
+        if (split.right != nullptr) {
+            Inner* root = new_node<Inner>();
+            root->keys[0] = std::move(split.key);
+            root->children[0] = _root;
+            root->children[1] = split.right;
+            root->count = 1;
+            _root = root;
+        }
+        if (res.second) _size++;
+        return res;
+    }
+
+    std::pair<iterator, bool> insert_or_assign(const K& key, const V& value) {
+        auto res = insert(key, value);
+        if (!res.second)
+            res.first.value() = value;
+        return res;
+    }
+
+    size_t erase(const K& key) {
+        if (_root == nullptr || !erase_rec(_root, key)) return 0;
+        _size--;
+        if (!_root->leaf && _root->count == 0) {
+            // 根只剩一个孩子，树高减一
+            Inner* old = as_inner(_root);
+            _root = old->children[0];
+            delete_node(old);
+        } else if (_root->leaf && _root->count == 0) {
+            delete_node(as_leaf(_root));
+            _root = nullptr;
+            _first = _last = nullptr;
+        }
+        return 1;
+    }
+
+    void clear() {
+        if (_root != nullptr) destroy(_root);
+        _root = nullptr;
+        _first = _last = nullptr;
+        _size = 0;
+    }
+
+    // 按键升序对 [lo, hi) 内的元素调用 f(key, value)：定位一次，之后沿叶子链表顺序扫描
+    template<typename F>
+    void scan(const K& lo, const K& hi, F f) const {
+        if (_root == nullptr) return;
+        const Leaf* leaf = const_cast<BTreeMap*>(this)->find_leaf(lo);
+        unsigned int i = rank<false>(leaf, lo);
+        for (; leaf != nullptr; leaf = leaf->next, i = 0) {
+            for (; i < leaf->count; ++i) {
+                if (!_less(leaf->keys[i], hi)) return;
+                f(leaf->keys[i], leaf->values[i]);
+            }
+        }
+    }
+
+private:
+    static constexpr unsigned int kMinLeafKeys = kMaxKeys / 2;
+    static constexpr unsigned int kMinInnerKeys = kMaxKeys / 2 - 1;
+
+    struct Split {
+        K key{};
+        Node* right = nullptr;
+    };
+
+    static Inner* as_inner(Node* node) { return static_cast<Inner*>(node); }
+    static const Inner* as_inner(const Node* node) { return static_cast<const Inner*>(node); }
+    static Leaf* as_leaf(Node* node) { return static_cast<Leaf*>(node); }
+
+    // 分配器只保证 max_align_t 对齐，节点需要按缓存行对齐
+    template<typename N>
+    static N* new_node() {
+        void* p = aligned_allocate<Allocator>(sizeof(N), CACHE_LINE_SIZE);
+        try {
+            return new (p) N();
+        } catch (...) {
+            aligned_deallocate<Allocator>(p, sizeof(N), CACHE_LINE_SIZE);
+            throw;
+        }
+    }
+
+    template<typename N>
+    static void delete_node(N* node) {
+        node->~N();
+        aligned_deallocate<Allocator>(node, sizeof(N), CACHE_LINE_SIZE);
+    }
+
+    // 节点内第一个 >= key（Inclusive 时为 > key）的下标
+    template<bool Inclusive>
+    unsigned int rank(const Node* node, const K& key) const {
+        if constexpr (kSimd) {
+            unsigned int r = simd::rank<Inclusive>(node->keys, key);
+            return r < node->count ? r : node->count;
+        } else if constexpr (Inclusive) {
+            return unsigned(std::upper_bound(node->keys, node->keys + node->count, key, _less) - node->keys);
+        } else {
+            return unsigned(std::lower_bound(node->keys, node->keys + node->count, key, _less) - node->keys);
+        }
+    }
+
+    // 分隔键 keys[i] 是 children[i+1] 子树中的最小键，所以等于分隔键时走右边
+    Leaf* find_leaf(const K& key) {
+        Node* node = _root;
+        while (!node->leaf)
+            node = as_inner(node)->children[rank<true>(node, key)];
+        return as_leaf(node);
+    }
+
+    std::pair<iterator, bool> insert_rec(Node* node, const K& key, const V& value, Split& split) {
+        if (node->leaf) {
+            Leaf* leaf = as_leaf(node);
+            unsigned int i = rank<false>(leaf, key);
+            if (i < leaf->count && !_less(key, leaf->keys[i]))
+                return {iterator(leaf, i), false};
+            if (leaf->count == kMaxKeys) {
+                Leaf* right = split_leaf(leaf);
+                split.key = right->keys[0];
+                split.right = right;
+                if (i > leaf->count) {
+                    i -= leaf->count;
+                    leaf = right;
+                }
+            }
+            insert_into_leaf(leaf, i, key, value);
+            return {iterator(leaf, i), true};
+        }
+
+        Inner* inner = as_inner(node);
+        unsigned int i = rank<true>(inner, key);
+        Split child;
+        std::pair<iterator, bool> res = insert_rec(inner->children[i], key, value, child);
+        if (child.right != nullptr) {
+            if (inner->count == kMaxKeys) {
+                // 先分裂本节点，中间键上移，再把孩子的分裂结果放进左半或右半
+                Inner* right = new_node<Inner>();
+                unsigned int mid = kMaxKeys / 2;
+                right->count = kMaxKeys - mid - 1;
+                std::move(inner->keys + mid + 1, inner->keys + kMaxKeys, right->keys);
+                std::copy(inner->children + mid + 1, inner->children + kMaxKeys + 1, right->children);
+                split.key = std::move(inner->keys[mid]);
+                split.right = right;
+                inner->count = mid;
+                clear_keys(inner, mid, kMaxKeys);
+                if (i > mid) {
+                    i -= mid + 1;
+                    inner = right;
+                }
+            }
+            std::move_backward(inner->keys + i, inner->keys + inner->count, inner->keys + inner->count + 1);
+            std::copy_backward(inner->children + i + 1, inner->children + inner->count + 1,
+                               inner->children + inner->count + 2);
+            inner->keys[i] = std::move(child.key);
+            inner->children[i + 1] = child.right;
+            inner->count++;
+        }
+        return res;
+    }
+
+    Leaf* split_leaf(Leaf* leaf) {
+        Leaf* right = new_node<Leaf>();
+        unsigned int mid = kMaxKeys / 2;
+        right->count = kMaxKeys - mid;
+        std::move(leaf->keys + mid, leaf->keys + kMaxKeys, right->keys);
+        std::move(leaf->values + mid, leaf->values + kMaxKeys, right->values);
+        leaf->count = mid;
+        clear_keys(leaf, mid, kMaxKeys);
+        right->next = leaf->next;
+        right->prev = leaf;
+        if (leaf->next != nullptr) leaf->next->prev = right;
+        else _last = right;
+        leaf->next = right;
+        return right;
+    }
+
+    void insert_into_leaf(Leaf* leaf, unsigned int i, const K& key, const V& value) {
+        std::move_backward(leaf->keys + i, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + i, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[i] = key;
+        leaf->values[i] = value;
+        leaf->count++;
+    }
+
+    // SIMD 查找依赖空位上的 simd::rank_padding 填充：元素移走后把 [from, to) 恢复成填充值
+    static void clear_keys(Node* node, unsigned int from, unsigned int to) {
+        if constexpr (kSimd)
+            std::fill(node->keys + from, node->keys + to, simd::rank_padding<K>());
+    }
+
+    // 返回是否找到并删除；孩子删除后不足半满时在本层修复
+    bool erase_rec(Node* node, const K& key) {
+        if (node->leaf) {
+            Leaf* leaf = as_leaf(node);
+            unsigned int i = rank<false>(leaf, key);
+            if (i == leaf->count || _less(key, leaf->keys[i])) return false;
+            std::move(leaf->keys + i + 1, leaf->keys + leaf->count, leaf->keys + i);
+            std::move(leaf->values + i + 1, leaf->values + leaf->count, leaf->values + i);
+            leaf->count--;
+            clear_keys(leaf, leaf->count, leaf->count + 1);
+            return true;
+        }
+        Inner* inner = as_inner(node);
+        unsigned int i = rank<true>(inner, key);
+        if (!erase_rec(inner->children[i], key)) return false;
+        Node* child = inner->children[i];
+        if (child->count < (child->leaf ? kMinLeafKeys : kMinInnerKeys))
+            rebalance(inner, i);
+        return true;
+    }
+
+    // children[i] 不足半满：优先向左右兄弟借一个，兄弟也只有半满时与它合并
+    void rebalance(Inner* parent, unsigned int i) {
+        Node* child = parent->children[i];
+        Node* left = i > 0 ? parent->children[i - 1] : nullptr;
+        Node* right = i < parent->count ? parent->children[i + 1] : nullptr;
+        unsigned int min_keys = child->leaf ? kMinLeafKeys : kMinInnerKeys;
+
+        if (left != nullptr && left->count > min_keys) {
+            borrow_from_left(parent, i);
+        } else if (right != nullptr && right->count > min_keys) {
+            borrow_from_right(parent, i);
+        } else if (right != nullptr) {
+            merge(parent, i);
+        } else {
+            merge(parent, i - 1);
+        }
+    }
+
+    void borrow_from_left(Inner* parent, unsigned int i) {
+        Node* child = parent->children[i];
+        Node* left = parent->children[i - 1];
+        std::move_backward(child->keys, child->keys + child->count, child->keys + child->count + 1);
+        if (child->leaf) {
+            Leaf* c = as_leaf(child);
+            Leaf* l = as_leaf(left);
+            std::move_backward(c->values, c->values + c->count, c->values + c->count + 1);
+            c->keys[0] = std::move(l->keys[l->count - 1]);
+            c->values[0] = std::move(l->values[l->count - 1]);
+            parent->keys[i - 1] = c->keys[0];
+        } else {
+            Inner* c = as_inner(child);
+            Inner* l = as_inner(left);
+            std::copy_backward(c->children, c->children + c->count + 1, c->children + c->count + 2);
+            c->keys[0] = std::move(parent->keys[i - 1]);
+            c->children[0] = l->children[l->count];
+            parent->keys[i - 1] = std::move(l->keys[l->count - 1]);
+        }
+        child->count++;
+        left->count--;
+        clear_keys(left, left->count, left->count + 1);
+    }
+
+    void borrow_from_right(Inner* parent, unsigned int i) {
+        Node* child = parent->children[i];
+        Node* right = parent->children[i + 1];
+        if (child->leaf) {
+            Leaf* c = as_leaf(child);
+            Leaf* r = as_leaf(right);
+            c->keys[c->count] = std::move(r->keys[0]);
+            c->values[c->count] = std::move(r->values[0]);
+            std::move(r->values + 1, r->values + r->count, r->values);
+            std::move(r->keys + 1, r->keys + r->count, r->keys);
+            parent->keys[i] = r->keys[0];
+        } else {
+            Inner* c = as_inner(child);
+            Inner* r = as_inner(right);
+            c->keys[c->count] = std::move(parent->keys[i]);
+            c->children[c->count + 1] = r->children[0];
+            parent->keys[i] = std::move(r->keys[0]);
+            std::move(r->keys + 1, r->keys + r->count, r->keys);
+            std::copy(r->children + 1, r->children + r->count + 1, r->children);
+        }
+        child->count++;
+        right->count--;
+        clear_keys(right, right->count, right->count + 1);
+    }
+
+    // 把 children[i + 1] 并入 children[i]，删除两者之间的分隔键
+    void merge(Inner* parent, unsigned int i) {
+        Node* left = parent->children[i];
+        Node* right = parent->children[i + 1];
+        if (left->leaf) {
+            Leaf* l = as_leaf(left);
+            Leaf* r = as_leaf(right);
+            std::move(r->keys, r->keys + r->count, l->keys + l->count);
+            std::move(r->values, r->values + r->count, l->values + l->count);
+            l->count += r->count;
+            l->next = r->next;
+            if (r->next != nullptr) r->next->prev = l;
+            else _last = l;
+            delete_node(r);
+        } else {
+            Inner* l = as_inner(left);
+            Inner* r = as_inner(right);
+            l->keys[l->count] = std::move(parent->keys[i]);
+            std::move(r->keys, r->keys + r->count, l->keys + l->count + 1);
+            std::copy(r->children, r->children + r->count + 1, l->children + l->count + 1);
+            l->count += r->count + 1;
+            delete_node(r);
+        }
+        std::move(parent->keys + i + 1, parent->keys + parent->count, parent->keys + i);
+        std::copy(parent->children + i + 2, parent->children + parent->count + 1, parent->children + i + 1);
+        parent->count--;
+        clear_keys(parent, parent->count, parent->count + 1);
+    }
+
+    void destroy(Node* node) {
+        if (node->leaf) {
+            delete_node(as_leaf(node));
+            return;
+        }
+        Inner* inner = as_inner(node);
+        for (unsigned int i = 0; i <= inner->count; ++i)
+            destroy(inner->children[i]);
+        delete_node(inner);
+    }
+
+    void take(BTreeMap& other) {
+        _root = other._root;
+        _first = other._first;
+        _last = other._last;
+        _size = other._size;
+        other._root = nullptr;
+        other._first = other._last = nullptr;
+        other._size = 0;
+    }
+
+    Node* _root = nullptr;
+    Leaf* _first = nullptr; // 最左叶子，begin()
+    Leaf* _last = nullptr;  // 最右叶子，end() 是它的末尾
+    size_t _size = 0;
+    Compare _less;
+};
+
+} // namespace d2ds
+
+#endif